@@ -0,0 +1,275 @@
+// Accuracy harness for the fast conversion paths.
+//
+// Every one of the 2^24 RGB inputs (or every `stride`-th with `bench_accuracy <stride>`) goes through each fast
+// path and through a double-precision reference, and the error statistics are compared against fixed budgets.
+// The process exits non-zero when any budget is exceeded, so it runs under ctest; tighten a budget when a kernel
+// improves and never loosen one without a reason in the commit.
+
+#include <pigment/pigment.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <mutex>
+#include <span>
+#include <utility>
+#include <vector>
+
+using namespace pigment;
+
+namespace {
+
+    // Running error statistics; `failures` counts samples whose error is above zero (round trips) or above the
+    // check's own tolerance
+    struct Stats {
+        double max = 0.0;
+        double sum = 0.0;
+        uint64_t count = 0;
+        uint64_t failures = 0;
+
+        void add(double error, bool failed) {
+            max = std::max(max, error);
+            sum += error;
+            ++count;
+            failures += failed;
+        }
+
+        void merge(const Stats &other) {
+            max = std::max(max, other.max);
+            sum += other.sum;
+            count += other.count;
+            failures += other.failures;
+        }
+
+        double mean() const { return count ? sum / count : 0.0; }
+    };
+
+    struct Budget {
+        double max;
+        double mean;
+        uint64_t failures;
+    };
+
+    struct Check {
+        const char *name;
+        const char *unit;
+        Budget budget;
+        // Error of one input; the bool marks a failure
+        std::function<std::pair<double, bool>(const RGB &)> error;
+        // Optional batch form for kernels that only exist as span conversions
+        std::function<void(std::span<const RGB>, Stats &)> batch;
+    };
+
+    RGB rgb_of(uint32_t key) { return RGB((key >> 16) & 0xFF, (key >> 8) & 0xFF, key & 0xFF); }
+
+    // Run `check` over every stride-th input, tiled over all cores
+    Stats measure(const Check &check, uint32_t stride) {
+        constexpr uint32_t TILE = 1u << 16;
+        const uint32_t total = (1u << 24);
+        Stats result;
+        std::mutex mutex;
+        parallel::ThreadExecutor executor;
+        executor(total / TILE, [&](size_t tile) {
+            Stats local;
+            std::vector<RGB> inputs;
+            inputs.reserve(TILE / stride + 1);
+            for (uint32_t key = static_cast<uint32_t>(tile) * TILE; key < (tile + 1) * TILE; key += stride) {
+                inputs.push_back(rgb_of(key));
+            }
+            if (check.batch) {
+                check.batch(inputs, local);
+            } else {
+                for (const RGB &c : inputs) {
+                    auto [error, failed] = check.error(c);
+                    local.add(error, failed);
+                }
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            result.merge(local);
+        });
+        return result;
+    }
+
+    double delta_e(const LAB &a, double l, double a_, double b) {
+        return std::sqrt((a.l() - l) * (a.l() - l) + (a.a() - a_) * (a.a() - a_) + (a.b() - b) * (a.b() - b));
+    }
+
+    double oklab_distance(const OKLAB &a, double l, double a_, double b) {
+        return std::sqrt((a.l() - l) * (a.l() - l) + (a.a() - a_) * (a.a() - a_) + (a.b() - b) * (a.b() - b));
+    }
+
+    int max_channel_error(const RGB &a, const RGB &b) {
+        return std::max({std::abs(a.r() - b.r()), std::abs(a.g() - b.g()), std::abs(a.b() - b.b())});
+    }
+
+    // Double-precision HSV reference with the same conventions as HSV::fromRGB
+    void reference_hsv(const RGB &c, double &h, double &s, double &v) {
+        const double r = c.r() / 255.0, g = c.g() / 255.0, b = c.b() / 255.0;
+        const double mx = std::max({r, g, b}), mn = std::min({r, g, b}), delta = mx - mn;
+        if (delta == 0.0) {
+            h = 0.0;
+        } else if (mx == r) {
+            h = 60.0 * std::fmod((g - b) / delta, 6.0);
+        } else if (mx == g) {
+            h = 60.0 * ((b - r) / delta + 2.0);
+        } else {
+            h = 60.0 * ((r - g) / delta + 4.0);
+        }
+        if (h < 0.0) {
+            h += 360.0;
+        }
+        s = mx == 0.0 ? 0.0 : delta / mx;
+        v = mx;
+    }
+
+    double hue_difference(double a, double b) {
+        double d = std::fabs(a - b);
+        return std::min(d, 360.0 - d);
+    }
+
+    template <lab_tables::Precision P> std::pair<double, bool> lab_from_rgb_error(const RGB &c) {
+        const LAB exact = LAB::fromRGB<lab_tables::Precision::EXACT>(c);
+        const LAB fast = LAB::fromRGB<P>(c);
+        const double error = delta_e(exact, fast.l(), fast.a(), fast.b());
+        return {error, error > 0.5};
+    }
+
+    template <lab_tables::Precision P> std::pair<double, bool> lab_round_trip_error(const RGB &c) {
+        const RGB back = LAB::fromRGB<lab_tables::Precision::EXACT>(c).to_rgb<P>();
+        const int error = max_channel_error(c, back);
+        return {static_cast<double>(error), error != 0};
+    }
+
+    std::vector<Check> checks() {
+        using lab_tables::Precision;
+        std::vector<Check> list;
+
+        // Budgets are {max, mean, failures over all 2^24 inputs}, set just above the measured values
+
+        // LAB: 4096-entry truncating tables (LUT) and interpolated tables against exact pow / cbrt
+        list.push_back({"LAB::fromRGB<LUT> vs exact", "dE76", {2.1, 0.13, 380000}, lab_from_rgb_error<Precision::LUT>,
+                        nullptr});
+        list.push_back({"LAB::fromRGB<INTERPOLATED> vs exact", "dE76", {0.01, 2e-4, 0},
+                        lab_from_rgb_error<Precision::INTERPOLATED>, nullptr});
+        list.push_back({"LAB::to_rgb<LUT> round trip", "channel", {10, 0.3, 4020000},
+                        lab_round_trip_error<Precision::LUT>, nullptr});
+        list.push_back({"LAB::to_rgb<INTERPOLATED> round trip", "channel", {0, 0, 0},
+                        lab_round_trip_error<Precision::INTERPOLATED>, nullptr});
+        list.push_back({"LAB::to_rgb<EXACT> round trip", "channel", {0, 0, 0}, lab_round_trip_error<Precision::EXACT>,
+                        nullptr});
+
+        // Float / SIMD batch kernels
+        list.push_back({"convert RGB -> LABf vs exact LAB", "dE76", {1e-3, 1e-4, 0}, nullptr,
+                        [](std::span<const RGB> in, Stats &stats) {
+                            std::vector<LABf> out(in.size());
+                            convert(in, std::span<LABf>(out));
+                            for (size_t i = 0; i < in.size(); ++i) {
+                                const LAB exact = LAB::fromRGB<Precision::EXACT>(in[i]);
+                                const double error = delta_e(exact, out[i].l(), out[i].a(), out[i].b());
+                                stats.add(error, error > 0.5);
+                            }
+                        }});
+        list.push_back({"convert RGB -> OKLABf vs OKLAB", "dOK", {5e-6, 5e-7, 0}, nullptr,
+                        [](std::span<const RGB> in, Stats &stats) {
+                            std::vector<OKLABf> out(in.size());
+                            convert(in, std::span<OKLABf>(out));
+                            for (size_t i = 0; i < in.size(); ++i) {
+                                const double error =
+                                    oklab_distance(OKLAB::fromRGB(in[i]), out[i].l(), out[i].a(), out[i].b());
+                                stats.add(error, error > 0.005);
+                            }
+                        }});
+        list.push_back({"convert RGB -> XYZf vs XYZ", "abs", {2e-5, 5e-6, 0}, nullptr,
+                        [](std::span<const RGB> in, Stats &stats) {
+                            std::vector<XYZf> out(in.size());
+                            convert(in, std::span<XYZf>(out));
+                            for (size_t i = 0; i < in.size(); ++i) {
+                                const XYZ exact = XYZ::fromRGB(in[i]);
+                                const double error = std::max({std::fabs(exact.x() - out[i].x()),
+                                                               std::fabs(exact.y() - out[i].y()),
+                                                               std::fabs(exact.z() - out[i].z())});
+                                stats.add(error, error > 0.01);
+                            }
+                        }});
+
+        // OKLAB fast paths against their documented bounds
+        list.push_back({"OKLAB::fromRGB_fast vs fromRGB", "abs",
+                        {oklab_tables::FAST_FROM_RGB_MAX_ERROR, oklab_tables::FAST_FROM_RGB_MAX_ERROR, 0},
+                        [](const RGB &c) {
+                            const OKLAB exact = OKLAB::fromRGB(c), fast = OKLAB::fromRGB_fast(c);
+                            const double error = std::max({std::fabs(exact.l() - fast.l()),
+                                                           std::fabs(exact.a() - fast.a()),
+                                                           std::fabs(exact.b() - fast.b())});
+                            return std::pair<double, bool>{error, error > oklab_tables::FAST_FROM_RGB_MAX_ERROR};
+                        },
+                        nullptr});
+        list.push_back({"OKLAB::to_rgb_fast vs to_rgb", "channel",
+                        {static_cast<double>(oklab_tables::FAST_TO_RGB_MAX_CHANNEL_ERROR), 0.01, 0},
+                        [](const RGB &c) {
+                            const OKLAB lab = OKLAB::fromRGB(c);
+                            const int error = max_channel_error(lab.to_rgb(), lab.to_rgb_fast());
+                            return std::pair<double, bool>{static_cast<double>(error),
+                                                           error > oklab_tables::FAST_TO_RGB_MAX_CHANNEL_ERROR};
+                        },
+                        nullptr});
+        list.push_back({"OKLAB::to_rgb round trip", "channel", {0, 0, 0},
+                        [](const RGB &c) {
+                            const int error = max_channel_error(c, OKLAB::fromRGB(c).to_rgb());
+                            return std::pair<double, bool>{static_cast<double>(error), error != 0};
+                        },
+                        nullptr});
+
+        // HSV is computed in float; HSL stores quantized channels, so its round trip is lossy by design
+        list.push_back({"HSV::fromRGB vs double reference", "abs", {1e-6, 1e-7, 0},
+                        [](const RGB &c) {
+                            double h, s, v;
+                            reference_hsv(c, h, s, v);
+                            const HSV fast = HSV::fromRGB(c);
+                            // hue in degrees scaled to the [0, 1] range of s and v
+                            const double error = std::max({hue_difference(h, fast.h()) / 360.0,
+                                                           std::fabs(s - fast.s()), std::fabs(v - fast.v())});
+                            return std::pair<double, bool>{error, error > 1e-4};
+                        },
+                        nullptr});
+        list.push_back({"HSV round trip", "channel", {0, 0, 0},
+                        [](const RGB &c) {
+                            const int error = max_channel_error(c, HSV::fromRGB(c).to_rgb());
+                            return std::pair<double, bool>{static_cast<double>(error), error != 0};
+                        },
+                        nullptr});
+        list.push_back({"HSL round trip", "channel", {2, 0.61, 9400000},
+                        [](const RGB &c) {
+                            const int error = max_channel_error(c, HSL::fromRGB(c).to_rgb());
+                            return std::pair<double, bool>{static_cast<double>(error), error != 0};
+                        },
+                        nullptr});
+        return list;
+    }
+
+} // namespace
+
+int main(int argc, char **argv) {
+    const uint32_t stride = argc > 1 ? static_cast<uint32_t>(std::max(1, std::atoi(argv[1]))) : 1;
+    // Failure budgets are for the full domain; scale them when sampling
+    const double sample_fraction = 1.0 / stride;
+
+    std::printf("%-40s %-8s %14s %14s %12s  %s\n", "path", "metric", "max", "mean", "failures", "result");
+    bool ok = true;
+    for (const Check &check : checks()) {
+        const Stats stats = measure(check, stride);
+        const uint64_t failure_budget = static_cast<uint64_t>(std::ceil(check.budget.failures * sample_fraction));
+        const bool pass = stats.max <= check.budget.max && stats.mean() <= check.budget.mean &&
+                          stats.failures <= failure_budget;
+        ok = ok && pass;
+        std::printf("%-40s %-8s %14.6g %14.6g %12llu  %s\n", check.name, check.unit, stats.max, stats.mean(),
+                    static_cast<unsigned long long>(stats.failures), pass ? "ok" : "OVER BUDGET");
+        if (!pass) {
+            std::printf("%-40s budget   %14.6g %14.6g %12llu\n", "", check.budget.max, check.budget.mean,
+                        static_cast<unsigned long long>(failure_budget));
+        }
+    }
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+#include <pigment/pigment.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace bench {
+
+    using namespace pigment;
+
+    // Image sizes every pixel benchmark runs at: a 256x256 thumbnail and a 1080p frame
+    constexpr int64_t THUMBNAIL = 256 * 256;
+    constexpr int64_t FULL_HD = 1920 * 1080;
+
+    // Photo-like test data: smooth gradients with per-pixel noise and some flat regions, so run-reuse and
+    // cache behaviour resemble real images rather than white noise
+    inline std::vector<RGB> make_image(size_t pixels, uint32_t seed = 0x5EED) {
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<int> noise(-12, 12);
+        const size_t width = static_cast<size_t>(std::sqrt(static_cast<double>(pixels))) + 1;
+        std::vector<RGB> image(pixels);
+        for (size_t i = 0; i < pixels; ++i) {
+            const size_t x = i % width, y = i / width;
+            if ((x / 64 + y / 64) % 5 == 0) {
+                image[i] = RGB(40, 90, 160); // flat patch
+                continue;
+            }
+            auto channel = [&](double base) { return static_cast<uint8_t>(std::clamp(base + noise(rng), 0.0, 255.0)); };
+            image[i] = RGB(channel(255.0 * x / width), channel(128.0 + 100.0 * std::sin(y * 0.01)),
+                           channel(255.0 * y / width), 255);
+        }
+        return image;
+    }
+
+    // Same image with varied alpha for the compositing benchmarks (opaque, transparent and partial runs)
+    inline std::vector<RGB> make_layer(size_t pixels, uint32_t seed = 0xA1FA) {
+        std::vector<RGB> layer = make_image(pixels, seed);
+        std::mt19937 rng(seed);
+        for (size_t i = 0; i < pixels; ++i) {
+            const size_t run = (i / 256) % 3;
+            layer[i].a() = run == 0 ? 255 : run == 1 ? 0 : static_cast<uint8_t>(rng() & 0xFF);
+        }
+        return layer;
+    }
+
+    // Fixed 64-entry palette taken from a differently seeded image
+    inline std::vector<RGB> make_palette(size_t size = 64) {
+        std::vector<RGB> source = make_image(size * 997, 0xC0105);
+        std::vector<RGB> palette;
+        for (size_t i = 0; i < size; ++i) {
+            palette.push_back(source[i * 997]);
+        }
+        return palette;
+    }
+
+    // Report throughput as pixels (items) per second
+    inline void set_pixels(benchmark::State &state, int64_t pixels_per_iteration) {
+        state.SetItemsProcessed(state.iterations() * pixels_per_iteration);
+    }
+
+} // namespace bench
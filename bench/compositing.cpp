@@ -0,0 +1,106 @@
+#include "common.hpp"
+
+using namespace bench;
+
+// Baseline: the per-pixel RGB members the span engine replaces
+static void BM_MemberAlphaBlend(benchmark::State &state) {
+    const auto layer = make_layer(static_cast<size_t>(state.range(0)));
+    const auto base = make_image(static_cast<size_t>(state.range(0)));
+    std::vector<RGB> out(base.size());
+    for (auto _ : state) {
+        for (size_t i = 0; i < layer.size(); ++i) {
+            out[i] = layer[i].alpha_blend(base[i]);
+        }
+        benchmark::ClobberMemory();
+    }
+    set_pixels(state, state.range(0));
+}
+BENCHMARK(BM_MemberAlphaBlend)->Arg(THUMBNAIL)->Arg(FULL_HD);
+
+static void BM_MemberMultiply(benchmark::State &state) {
+    const auto layer = make_layer(static_cast<size_t>(state.range(0)));
+    const auto base = make_image(static_cast<size_t>(state.range(0)));
+    std::vector<RGB> out(base.size());
+    for (auto _ : state) {
+        for (size_t i = 0; i < layer.size(); ++i) {
+            out[i] = base[i].blend_multiply(layer[i]);
+        }
+        benchmark::ClobberMemory();
+    }
+    set_pixels(state, state.range(0));
+}
+BENCHMARK(BM_MemberMultiply)->Arg(THUMBNAIL)->Arg(FULL_HD);
+
+static void BM_BlendSpan(benchmark::State &state) {
+    const auto layer = make_layer(static_cast<size_t>(state.range(0)));
+    const auto base = make_image(static_cast<size_t>(state.range(0)));
+    const auto mode = static_cast<BlendMode>(state.range(1));
+    std::vector<RGB> out(base.size());
+    for (auto _ : state) {
+        state.PauseTiming();
+        out = base;
+        state.ResumeTiming();
+        blend(mode, std::span<const RGB>(layer), std::span<RGB>(out));
+        benchmark::ClobberMemory();
+    }
+    set_pixels(state, state.range(0));
+}
+BENCHMARK(BM_BlendSpan)
+    ->ArgsProduct({{THUMBNAIL, FULL_HD},
+                   {static_cast<int64_t>(BlendMode::NORMAL), static_cast<int64_t>(BlendMode::ADD),
+                    static_cast<int64_t>(BlendMode::SUBTRACT), static_cast<int64_t>(BlendMode::MULTIPLY),
+                    static_cast<int64_t>(BlendMode::SCREEN), static_cast<int64_t>(BlendMode::OVERLAY)}});
+
+static void BM_CompositePremultiplied(benchmark::State &state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    std::vector<PremulRGBA> layer(n), base(n), out(n);
+    premultiply(make_layer(n), layer);
+    premultiply(make_image(n), base);
+    const auto op = static_cast<PorterDuff>(state.range(1));
+    for (auto _ : state) {
+        state.PauseTiming();
+        out = base;
+        state.ResumeTiming();
+        composite(op, std::span<const PremulRGBA>(layer), std::span<PremulRGBA>(out));
+        benchmark::ClobberMemory();
+    }
+    set_pixels(state, state.range(0));
+}
+BENCHMARK(BM_CompositePremultiplied)
+    ->ArgsProduct({{FULL_HD},
+                   {static_cast<int64_t>(PorterDuff::SRC_OVER), static_cast<int64_t>(PorterDuff::SRC_ATOP),
+                    static_cast<int64_t>(PorterDuff::XOR), static_cast<int64_t>(PorterDuff::PLUS)}});
+
+static void BM_CompositeLinear(benchmark::State &state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    std::vector<LinearRGBA> layer(n), base(n), out(n);
+    to_linear(make_layer(n), layer);
+    to_linear(make_image(n), base);
+    for (auto _ : state) {
+        state.PauseTiming();
+        out = base;
+        state.ResumeTiming();
+        composite(PorterDuff::SRC_OVER, std::span<const LinearRGBA>(layer), std::span<LinearRGBA>(out));
+        benchmark::ClobberMemory();
+    }
+    set_pixels(state, state.range(0));
+}
+BENCHMARK(BM_CompositeLinear)->Arg(FULL_HD);
+
+static void BM_ColormapMap(benchmark::State &state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    std::vector<float> values(n);
+    for (size_t i = 0; i < n; ++i) {
+        values[i] = std::sin(i * 0.001f);
+    }
+    const Colormap colormap(std::vector<RGB>{RGB(0, 0, 128), RGB(255, 255, 255), RGB(180, 0, 0)});
+    std::vector<RGB> out(n);
+    for (auto _ : state) {
+        colormap.map(values, out, -1.0f, 1.0f);
+        benchmark::ClobberMemory();
+    }
+    set_pixels(state, state.range(0));
+}
+BENCHMARK(BM_ColormapMap)->Arg(FULL_HD);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,187 @@
+#include "common.hpp"
+
+using namespace bench;
+
+// Scalar RGB -> T, one call per pixel through color_traits (same path as T::fromRGB)
+template <typename T> static void BM_ScalarFromRGB(benchmark::State &state) {
+    const auto image = make_image(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        for (const RGB &c : image) {
+            T converted = color_traits<T>::from_rgb(c);
+            benchmark::DoNotOptimize(converted);
+        }
+    }
+    set_pixels(state, state.range(0));
+}
+
+// Scalar T -> RGB
+template <typename T> static void BM_ScalarToRGB(benchmark::State &state) {
+    const auto image = make_image(static_cast<size_t>(state.range(0)));
+    std::vector<T> source(image.size());
+    convert(std::span<const RGB>(image), std::span<T>(source));
+    for (auto _ : state) {
+        for (const T &c : source) {
+            RGB converted = color_traits<T>::to_rgb(c);
+            benchmark::DoNotOptimize(converted);
+        }
+    }
+    set_pixels(state, state.range(0));
+}
+
+// Batch RGB -> T (SIMD kernels where available)
+template <typename T> static void BM_BatchFromRGB(benchmark::State &state) {
+    const auto image = make_image(static_cast<size_t>(state.range(0)));
+    std::vector<T> out(image.size());
+    for (auto _ : state) {
+        convert(std::span<const RGB>(image), std::span<T>(out));
+        benchmark::ClobberMemory();
+    }
+    set_pixels(state, state.range(0));
+}
+
+// Batch T -> RGB
+template <typename T> static void BM_BatchToRGB(benchmark::State &state) {
+    const auto image = make_image(static_cast<size_t>(state.range(0)));
+    std::vector<T> source(image.size());
+    convert(std::span<const RGB>(image), std::span<T>(source));
+    std::vector<RGB> out(image.size());
+    for (auto _ : state) {
+        convert(std::span<const T>(source), std::span<RGB>(out));
+        benchmark::ClobberMemory();
+    }
+    set_pixels(state, state.range(0));
+}
+
+// Planar RGB -> T against the interleaved batch API
+template <typename T> static void BM_PlanarFromRGB(benchmark::State &state) {
+    const auto image = make_image(static_cast<size_t>(state.range(0)));
+    auto planar = PlanarImage<RGB>::from_interleaved(std::span<const RGB>(image), image.size(), 1);
+    PlanarImage<T> out(image.size(), 1);
+    for (auto _ : state) {
+        convert(planar, out);
+        benchmark::ClobberMemory();
+    }
+    set_pixels(state, state.range(0));
+}
+
+#define PIGMENT_BENCH_CONVERSIONS(T)                                                                                   \
+    BENCHMARK_TEMPLATE(BM_ScalarFromRGB, T)->Arg(THUMBNAIL)->Arg(FULL_HD);                                             \
+    BENCHMARK_TEMPLATE(BM_ScalarToRGB, T)->Arg(THUMBNAIL)->Arg(FULL_HD);                                               \
+    BENCHMARK_TEMPLATE(BM_BatchFromRGB, T)->Arg(THUMBNAIL)->Arg(FULL_HD);                                              \
+    BENCHMARK_TEMPLATE(BM_BatchToRGB, T)->Arg(THUMBNAIL)->Arg(FULL_HD)
+
+PIGMENT_BENCH_CONVERSIONS(MONO);
+PIGMENT_BENCH_CONVERSIONS(HSL);
+PIGMENT_BENCH_CONVERSIONS(HSV);
+PIGMENT_BENCH_CONVERSIONS(LAB);
+PIGMENT_BENCH_CONVERSIONS(LCH);
+PIGMENT_BENCH_CONVERSIONS(XYZ);
+PIGMENT_BENCH_CONVERSIONS(OKLAB);
+PIGMENT_BENCH_CONVERSIONS(LABf);
+PIGMENT_BENCH_CONVERSIONS(LCHf);
+PIGMENT_BENCH_CONVERSIONS(XYZf);
+PIGMENT_BENCH_CONVERSIONS(OKLABf);
+
+BENCHMARK_TEMPLATE(BM_PlanarFromRGB, LABf)->Arg(THUMBNAIL)->Arg(FULL_HD);
+BENCHMARK_TEMPLATE(BM_PlanarFromRGB, OKLABf)->Arg(THUMBNAIL)->Arg(FULL_HD);
+
+// Alternative scalar paths: precision modes and the fast OKLAB variants
+template <lab_tables::Precision P> static void BM_LabPrecision(benchmark::State &state) {
+    const auto image = make_image(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        for (const RGB &c : image) {
+            LAB lab = LAB::fromRGB<P>(c);
+            benchmark::DoNotOptimize(lab);
+        }
+    }
+    set_pixels(state, state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_LabPrecision, lab_tables::Precision::LUT)->Arg(THUMBNAIL);
+BENCHMARK_TEMPLATE(BM_LabPrecision, lab_tables::Precision::INTERPOLATED)->Arg(THUMBNAIL);
+BENCHMARK_TEMPLATE(BM_LabPrecision, lab_tables::Precision::EXACT)->Arg(THUMBNAIL);
+
+static void BM_OklabFromRGBFast(benchmark::State &state) {
+    const auto image = make_image(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        for (const RGB &c : image) {
+            OKLAB ok = OKLAB::fromRGB_fast(c);
+            benchmark::DoNotOptimize(ok);
+        }
+    }
+    set_pixels(state, state.range(0));
+}
+BENCHMARK(BM_OklabFromRGBFast)->Arg(THUMBNAIL);
+
+static void BM_ConversionCacheLookup(benchmark::State &state) {
+    const auto image = make_image(static_cast<size_t>(state.range(0)));
+    static ConversionCache<LAB> cache;
+    std::vector<LAB> out(image.size());
+    cache.get(std::span<const RGB>(image), std::span<LAB>(out)); // warm the touched pages
+    for (auto _ : state) {
+        cache.get(std::span<const RGB>(image), std::span<LAB>(out));
+        benchmark::ClobberMemory();
+    }
+    set_pixels(state, state.range(0));
+}
+BENCHMARK(BM_ConversionCacheLookup)->Arg(THUMBNAIL)->Arg(FULL_HD);
+
+static void BM_Lut3DApply(benchmark::State &state) {
+    const auto image = make_image(static_cast<size_t>(state.range(0)));
+    const Lut3D lut = Lut3D::bake([](const RGB &c) { return c.brighten(0.1); }, Lut3D::MEDIUM);
+    std::vector<RGB> out(image.size());
+    for (auto _ : state) {
+        lut.apply(std::span<const RGB>(image), std::span<RGB>(out), static_cast<Lut3D::Interpolation>(state.range(1)));
+        benchmark::ClobberMemory();
+    }
+    set_pixels(state, state.range(0));
+}
+BENCHMARK(BM_Lut3DApply)->Args({FULL_HD, 0})->Args({FULL_HD, 1});
+
+static void BM_ColorBlindnessSimulate(benchmark::State &state) {
+    const auto image = make_image(static_cast<size_t>(state.range(0)));
+    std::vector<RGB> out(image.size());
+    for (auto _ : state) {
+        for (size_t i = 0; i < image.size(); ++i) {
+            out[i] = utils::ColorBlindness::simulate(image[i], utils::ColorBlindness::DEUTERANOMALY);
+        }
+        benchmark::ClobberMemory();
+    }
+    set_pixels(state, state.range(0));
+}
+BENCHMARK(BM_ColorBlindnessSimulate)->Arg(FULL_HD);
+
+static void BM_ColorVisionApply(benchmark::State &state) {
+    const auto image = make_image(static_cast<size_t>(state.range(0)));
+    const ColorVision filter(ColorVision::Deficiency::DEUTAN, 0.5, static_cast<ColorVision::Mode>(state.range(1)));
+    std::vector<RGB> out(image.size());
+    for (auto _ : state) {
+        filter.apply(std::span<const RGB>(image), std::span<RGB>(out));
+        benchmark::ClobberMemory();
+    }
+    set_pixels(state, state.range(0));
+}
+BENCHMARK(BM_ColorVisionApply)->Args({FULL_HD, 0})->Args({FULL_HD, 1});
+
+// A theme-style chain: range 1 = 0 runs the chained HSL / HSV calls, 1 the folded ColorTransform
+static void BM_HslChain(benchmark::State &state) {
+    const auto image = make_image(static_cast<size_t>(state.range(0)));
+    ColorTransform transform;
+    transform.adjust_hue(20).saturate(0.1).lighten(0.05).hsv_adjust_brightness(0.1);
+    std::vector<RGB> out(image.size());
+    for (auto _ : state) {
+        if (state.range(1) == 0) {
+            for (size_t i = 0; i < image.size(); ++i) {
+                HSV hsv = HSV::fromRGB(HSL::fromRGB(image[i]).adjust_hue(20).saturate(0.1).lighten(0.05).to_rgb());
+                hsv.adjust_brightness(0.1f);
+                out[i] = hsv.to_rgb();
+            }
+        } else {
+            transform.apply(std::span<const RGB>(image), std::span<RGB>(out));
+        }
+        benchmark::ClobberMemory();
+    }
+    set_pixels(state, state.range(0));
+}
+BENCHMARK(BM_HslChain)->Args({THUMBNAIL, 0})->Args({THUMBNAIL, 1});
+
+BENCHMARK_MAIN();
@@ -0,0 +1,168 @@
+#include "common.hpp"
+
+using namespace bench;
+
+// Pixels per find_closest_color benchmark iteration; the linear scan converts 2 * palette colors per query
+constexpr int64_t QUERIES = 4096;
+
+static void BM_FindClosestColor(benchmark::State &state) {
+    const auto image = make_image(QUERIES);
+    const auto palette = make_palette(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        for (const RGB &c : image) {
+            benchmark::DoNotOptimize(utils::find_closest_color(c, palette));
+        }
+    }
+    set_pixels(state, QUERIES);
+}
+BENCHMARK(BM_FindClosestColor)->Arg(16)->Arg(64)->Arg(256);
+
+static void BM_FindClosestColorCached(benchmark::State &state) {
+    const auto image = make_image(QUERIES);
+    const auto palette = make_palette(static_cast<size_t>(state.range(0)));
+    static ConversionCache<LAB> cache;
+    for (auto _ : state) {
+        for (const RGB &c : image) {
+            benchmark::DoNotOptimize(utils::find_closest_color(c, palette, cache));
+        }
+    }
+    set_pixels(state, QUERIES);
+}
+BENCHMARK(BM_FindClosestColorCached)->Arg(16)->Arg(64)->Arg(256);
+
+static void BM_PaletteIndexNearest(benchmark::State &state) {
+    const auto image = make_image(QUERIES);
+    const PaletteIndex index(make_palette(static_cast<size_t>(state.range(0))));
+    for (auto _ : state) {
+        for (const RGB &c : image) {
+            benchmark::DoNotOptimize(index.nearest(c));
+        }
+    }
+    set_pixels(state, QUERIES);
+}
+BENCHMARK(BM_PaletteIndexNearest)->Arg(16)->Arg(64)->Arg(256);
+
+static void BM_QuantizeToPalette(benchmark::State &state) {
+    const auto image = make_image(static_cast<size_t>(state.range(0)));
+    const auto palette = make_palette();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(utils::quantize_to_palette(image, palette));
+    }
+    set_pixels(state, state.range(0));
+}
+BENCHMARK(BM_QuantizeToPalette)->Arg(THUMBNAIL)->Arg(FULL_HD)->Unit(benchmark::kMillisecond);
+
+static void BM_QuantizeToPaletteSpan(benchmark::State &state) {
+    const auto image = make_image(static_cast<size_t>(state.range(0)));
+    const PaletteIndex index(make_palette());
+    std::vector<RGB> out(image.size());
+    for (auto _ : state) {
+        utils::quantize_to_palette(std::span<const RGB>(image), index, std::span<RGB>(out),
+                                   parallel::SerialExecutor{});
+        benchmark::ClobberMemory();
+    }
+    set_pixels(state, state.range(0));
+}
+BENCHMARK(BM_QuantizeToPaletteSpan)->Arg(THUMBNAIL)->Arg(FULL_HD)->Unit(benchmark::kMillisecond);
+
+static void BM_Dither(benchmark::State &state) {
+    constexpr size_t WIDTH = 1920;
+    const auto image = make_image(FULL_HD);
+    const PaletteIndex index(make_palette(64));
+    std::vector<RGB> out(image.size());
+    const auto method = static_cast<dither::Method>(state.range(0));
+    for (auto _ : state) {
+        dither::quantize(std::span<const RGB>(image), WIDTH, index, out, method);
+        benchmark::ClobberMemory();
+    }
+    set_pixels(state, FULL_HD);
+}
+BENCHMARK(BM_Dither)->DenseRange(0, 4)->Unit(benchmark::kMillisecond);
+
+static void BM_ExtractDominantColors(benchmark::State &state) {
+    const auto image = make_image(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(utils::extract_dominant_colors(image, 8));
+    }
+    set_pixels(state, state.range(0));
+}
+BENCHMARK(BM_ExtractDominantColors)->Arg(THUMBNAIL)->Unit(benchmark::kMillisecond);
+
+static void BM_MedianCut(benchmark::State &state) {
+    const auto image = make_image(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(dominant::median_cut(image, 8, {}, parallel::SerialExecutor{}));
+    }
+    set_pixels(state, state.range(0));
+}
+BENCHMARK(BM_MedianCut)->Arg(THUMBNAIL)->Arg(FULL_HD)->Unit(benchmark::kMillisecond);
+
+static void BM_KMeans(benchmark::State &state) {
+    const auto image = make_image(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(dominant::kmeans(image, 8, {}, parallel::SerialExecutor{}));
+    }
+    set_pixels(state, state.range(0));
+}
+BENCHMARK(BM_KMeans)->Arg(THUMBNAIL)->Arg(FULL_HD)->Unit(benchmark::kMillisecond);
+
+static void BM_HistogramBuild(benchmark::State &state) {
+    const auto image = make_image(FULL_HD);
+    const auto bits = static_cast<unsigned>(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Histogram::build(image, bits).total());
+    }
+    set_pixels(state, FULL_HD);
+}
+BENCHMARK(BM_HistogramBuild)->Arg(5)->Arg(8)->Unit(benchmark::kMillisecond);
+
+static void BM_RemoveDuplicates(benchmark::State &state) {
+    const auto colors = make_image(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(utils::remove_duplicates(colors));
+    }
+    set_pixels(state, state.range(0));
+}
+BENCHMARK(BM_RemoveDuplicates)->Arg(4096)->Arg(THUMBNAIL)->Unit(benchmark::kMillisecond);
+
+static void BM_SortByHue(benchmark::State &state) {
+    const auto image = make_image(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        auto colors = image;
+        utils::sort_by_hue(colors);
+        benchmark::DoNotOptimize(colors.data());
+    }
+    set_pixels(state, state.range(0));
+}
+BENCHMARK(BM_SortByHue)->Arg(THUMBNAIL)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+
+// Range 0 returns a new Palette each time, range 1 refills the same buffer; both multithreaded
+static void BM_PastelPalette(benchmark::State &state) {
+    std::array<RGB, 8> buffer;
+    for (auto _ : state) {
+        if (state.range(0) == 0) {
+            benchmark::DoNotOptimize(Palette::pastel(buffer.size()));
+        } else {
+            Palette::pastel(buffer);
+            benchmark::DoNotOptimize(buffer.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PastelPalette)->Arg(0)->Arg(1)->ThreadRange(1, 4);
+
+static void BM_DeltaE2000Batch(benchmark::State &state) {
+    const auto image = make_image(static_cast<size_t>(state.range(0)));
+    std::vector<LAB> lab(image.size());
+    convert(std::span<const RGB>(image), std::span<LAB>(lab));
+    std::vector<double> out(lab.size());
+    const LAB reference = LAB::fromRGB(RGB(200, 30, 60));
+    for (auto _ : state) {
+        delta_e_2000(reference, std::span<const LAB>(lab), std::span<double>(out));
+        benchmark::ClobberMemory();
+    }
+    set_pixels(state, state.range(0));
+}
+BENCHMARK(BM_DeltaE2000Batch)->Arg(THUMBNAIL);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,106 @@
+#include "common.hpp"
+
+#include <pigment/named_colors.hpp>
+
+#include <string>
+
+using namespace bench;
+
+// Hex and CSS strings as they appear in theme payloads
+static std::vector<std::string> make_strings(size_t count, bool css) {
+    const auto colors = make_image(count);
+    std::vector<std::string> strings;
+    strings.reserve(count);
+    for (const RGB &c : colors) {
+        strings.push_back(css ? "rgba(" + std::to_string(c.r()) + ", " + std::to_string(c.g()) + ", " +
+                                    std::to_string(c.b()) + ", 0.5)"
+                              : c.to_hex());
+    }
+    return strings;
+}
+
+constexpr int64_t STRINGS = 16384;
+
+static void BM_ConstructFromHex(benchmark::State &state) {
+    const auto strings = make_strings(STRINGS, false);
+    for (auto _ : state) {
+        for (const auto &s : strings) {
+            benchmark::DoNotOptimize(RGB(s));
+        }
+    }
+    set_pixels(state, STRINGS);
+}
+BENCHMARK(BM_ConstructFromHex);
+
+static void BM_ParseHex(benchmark::State &state) {
+    const auto strings = make_strings(STRINGS, false);
+    for (auto _ : state) {
+        for (const auto &s : strings) {
+            benchmark::DoNotOptimize(RGB::parse_hex(s));
+        }
+    }
+    set_pixels(state, STRINGS);
+}
+BENCHMARK(BM_ParseHex);
+
+static void BM_ConstructFromCss(benchmark::State &state) {
+    const auto strings = make_strings(STRINGS, true);
+    for (auto _ : state) {
+        for (const auto &s : strings) {
+            benchmark::DoNotOptimize(RGB(s));
+        }
+    }
+    set_pixels(state, STRINGS);
+}
+BENCHMARK(BM_ConstructFromCss);
+
+static void BM_ParseCss(benchmark::State &state) {
+    const auto strings = make_strings(STRINGS, true);
+    for (auto _ : state) {
+        for (const auto &s : strings) {
+            benchmark::DoNotOptimize(RGB::parse(s));
+        }
+    }
+    set_pixels(state, STRINGS);
+}
+BENCHMARK(BM_ParseCss);
+
+static void BM_ToHexString(benchmark::State &state) {
+    const auto colors = make_image(STRINGS);
+    for (auto _ : state) {
+        for (const RGB &c : colors) {
+            benchmark::DoNotOptimize(c.to_hex(true));
+        }
+    }
+    set_pixels(state, STRINGS);
+}
+BENCHMARK(BM_ToHexString);
+
+static void BM_ToHexBuffer(benchmark::State &state) {
+    const auto colors = make_image(STRINGS);
+    char buffer[RGB::HEX_MAX_LENGTH];
+    for (auto _ : state) {
+        for (const RGB &c : colors) {
+            benchmark::DoNotOptimize(c.to_hex(buffer, true));
+            benchmark::ClobberMemory();
+        }
+    }
+    set_pixels(state, STRINGS);
+}
+BENCHMARK(BM_ToHexBuffer);
+
+static void BM_NamedColorLookup(benchmark::State &state) {
+    std::vector<std::string_view> names;
+    for (const auto &entry : colors::TABLE) {
+        names.push_back(entry.name);
+    }
+    for (auto _ : state) {
+        for (std::string_view name : names) {
+            benchmark::DoNotOptimize(colors::lookup(name));
+        }
+    }
+    set_pixels(state, static_cast<int64_t>(names.size()));
+}
+BENCHMARK(BM_NamedColorLookup);
+
+BENCHMARK_MAIN();
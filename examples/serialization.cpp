@@ -113,6 +113,43 @@ int main() {
     std::cout << "Restored HSL: H=" << restored_hsl.get_h() << " S=" << restored_hsl.get_s()
               << " L=" << restored_hsl.get_l() << std::endl;
 
+    // -------------------------------------------------------------------------
+    // Single-precision LAB serialization
+    // -------------------------------------------------------------------------
+    std::cout << "\n--- LABf Serialization ---" << std::endl;
+
+    LABf lab_f = LABf::fromRGB(RGB(255, 128, 64));
+    std::cout << "Original LABf: L=" << lab_f.l() << " a=" << lab_f.a() << " b=" << lab_f.b() << std::endl;
+
+    dp::ByteBuf lab_buf = dp::serialize(lab_f);
+    std::cout << "Serialized size: " << lab_buf.size() << " bytes (LAB: " << dp::serialize(lab_f.to_lab()).size()
+              << " bytes)" << std::endl;
+
+    LABf restored_lab = dp::deserialize<dp::Mode::NONE, LABf>(lab_buf);
+    std::cout << "Restored LABf: L=" << restored_lab.l() << " a=" << restored_lab.a() << " b=" << restored_lab.b()
+              << std::endl;
+
+    // -------------------------------------------------------------------------
+    // Bulk serialization: one header, raw payload, zero-copy view
+    // -------------------------------------------------------------------------
+    std::cout << "\n--- Bulk Serialization ---" << std::endl;
+
+    namespace ser = serialization;
+    Palette ramp = Palette::gradient(RGB::black(), RGB("#FF8040"), 4096);
+    dp::ByteBuf bulk_buf = ser::serialize<dp::ByteBuf>(ramp);
+    dp::ByteBuf delta_buf = ser::serialize<dp::ByteBuf>(ramp, ser::Layout::DELTA);
+    std::cout << "4096-color gradient: " << bulk_buf.size() << " bytes interleaved, " << delta_buf.size()
+              << " bytes delta-coded" << std::endl;
+
+    // Interleaved data is read in place (from a buffer here, or from a file via ser::Archive)
+    ser::View<RGB> bulk_view = ser::view<RGB>(bulk_buf);
+    std::cout << "Viewed " << bulk_view.size() << " colors, last: " << bulk_view.colors().back().to_hex()
+              << std::endl;
+
+    Palette restored_ramp(ser::view<RGB>(delta_buf).to_vector());
+    std::cout << "  Delta round trip match: "
+              << (std::equal(ramp.begin(), ramp.end(), restored_ramp.begin()) ? "YES" : "NO") << std::endl;
+
     // -------------------------------------------------------------------------
     // Hex dump of serialized data
     // -------------------------------------------------------------------------
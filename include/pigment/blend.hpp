@@ -0,0 +1,370 @@
+#pragma once
+
+#include "planar.hpp"
+#include "simd.hpp"
+#include "types_basic.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+
+namespace pigment {
+
+    /**
+     * @brief Compositing modes for blend()
+     *
+     * NORMAL is Porter-Duff source-over on straight (non-premultiplied) alpha. The separable modes compute
+     * B(dst, src) per channel like RGB::blend_add / blend_subtract / blend_multiply / blend_screen /
+     * blend_overlay (called on dst with src as the argument) and apply it with src alpha as coverage; for an
+     * opaque src the color channels equal the RGB member results exactly.
+     */
+    enum class BlendMode { NORMAL, ADD, SUBTRACT, MULTIPLY, SCREEN, OVERLAY };
+
+    namespace blend_detail {
+
+        // Exact floor(x / 255) for x < 2^16
+        inline uint32_t div255_floor(uint32_t x) { return (x * 0x8081u) >> 23; }
+
+        // Exact round(x / 255) for x <= 255 * 255
+        inline uint32_t div255_round(uint32_t x) {
+            x += 128;
+            return (x + (x >> 8)) >> 8;
+        }
+
+        template <BlendMode Mode> inline uint32_t separable(uint32_t d, uint32_t s) {
+            if constexpr (Mode == BlendMode::ADD) {
+                return d + s > 255 ? 255 : d + s;
+            } else if constexpr (Mode == BlendMode::SUBTRACT) {
+                return d > s ? d - s : 0;
+            } else if constexpr (Mode == BlendMode::MULTIPLY) {
+                return div255_floor(d * s);
+            } else if constexpr (Mode == BlendMode::SCREEN) {
+                return 255 - div255_floor((255 - d) * (255 - s));
+            } else {
+                return d < 128 ? div255_floor(2 * d * s) : 255 - div255_floor(2 * (255 - d) * (255 - s));
+            }
+        }
+
+        // 2^24 / n rounded up: (x * RECIPROCAL[n]) >> 24 == x / n for every x <= 65152
+        inline const std::array<uint32_t, 256> &reciprocal_table() {
+            static const auto table = [] {
+                std::array<uint32_t, 256> t{};
+                for (uint32_t n = 1; n < 256; ++n) {
+                    t[n] = ((1u << 24) + n - 1) / n;
+                }
+                return t;
+            }();
+            return table;
+        }
+
+        // Straight-alpha source-over without floating point
+        inline void over(const uint8_t *s, uint8_t *d) {
+            const uint32_t as = s[3];
+            if (as == 255) {
+                std::memcpy(d, s, 4);
+                return;
+            }
+            if (as == 0) {
+                return;
+            }
+            const uint32_t dst_weight = div255_round(d[3] * (255 - as));
+            const uint32_t ao = as + dst_weight;
+            const uint32_t recip = reciprocal_table()[ao];
+            for (int c = 0; c < 3; ++c) {
+                d[c] = static_cast<uint8_t>(((s[c] * as + d[c] * dst_weight + ao / 2) * uint64_t(recip)) >> 24);
+            }
+            d[3] = static_cast<uint8_t>(ao);
+        }
+
+        template <BlendMode Mode> inline void pixel(const uint8_t *s, uint8_t *d) {
+            if constexpr (Mode == BlendMode::NORMAL) {
+                over(s, d);
+            } else {
+                const uint32_t as = s[3];
+                if (as == 0) {
+                    return;
+                }
+                for (int c = 0; c < 3; ++c) {
+                    const uint32_t mixed = separable<Mode>(d[c], s[c]);
+                    d[c] = static_cast<uint8_t>(div255_round(mixed * as + d[c] * (255 - as)));
+                }
+                d[3] = static_cast<uint8_t>(as + div255_round(d[3] * (255 - as)));
+            }
+        }
+
+        // Premultiplied source-over and the division-free premultiplied forms of ADD / MULTIPLY / SCREEN
+        template <BlendMode Mode> inline void pixel_premultiplied(const uint8_t *s, uint8_t *d) {
+            const uint32_t inv_as = 255 - s[3];
+            if constexpr (Mode == BlendMode::NORMAL) {
+                for (int c = 0; c < 4; ++c) {
+                    const uint32_t v = s[c] + div255_round(d[c] * inv_as);
+                    d[c] = static_cast<uint8_t>(v > 255 ? 255 : v);
+                }
+            } else if constexpr (Mode == BlendMode::ADD) {
+                for (int c = 0; c < 4; ++c) {
+                    d[c] = static_cast<uint8_t>(s[c] + d[c] > 255 ? 255 : s[c] + d[c]);
+                }
+            } else if constexpr (Mode == BlendMode::MULTIPLY) {
+                const uint32_t inv_ad = 255 - d[3];
+                for (int c = 0; c < 3; ++c) {
+                    uint32_t v = div255_round(s[c] * d[c] + s[c] * inv_ad + d[c] * inv_as);
+                    d[c] = static_cast<uint8_t>(v > 255 ? 255 : v);
+                }
+                d[3] = static_cast<uint8_t>(s[3] + div255_round(d[3] * inv_as));
+            } else {
+                for (int c = 0; c < 4; ++c) {
+                    d[c] = static_cast<uint8_t>(s[c] + d[c] - div255_round(s[c] * d[c]));
+                }
+            }
+        }
+
+#ifdef PIGMENT_SIMD_AVX2
+        // 16-bit lane helpers (16 channels = 4 pixels per register)
+        inline __m256i div255_floor16(__m256i x) {
+            return _mm256_srli_epi16(_mm256_mulhi_epu16(x, _mm256_set1_epi16(static_cast<short>(0x8081))), 7);
+        }
+
+        inline __m256i div255_round16(__m256i x) {
+            x = _mm256_add_epi16(x, _mm256_set1_epi16(128));
+            return _mm256_srli_epi16(_mm256_add_epi16(x, _mm256_srli_epi16(x, 8)), 8);
+        }
+
+        // Replicate each pixel's alpha (lane 3 of every group of 4) across its channels
+        inline __m256i broadcast_alpha16(__m256i x) {
+            return _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(x, 0xFF), 0xFF);
+        }
+
+        template <BlendMode Mode> inline __m256i separable16(__m256i d, __m256i s) {
+            const __m256i c255 = _mm256_set1_epi16(255);
+            if constexpr (Mode == BlendMode::MULTIPLY) {
+                return div255_floor16(_mm256_mullo_epi16(d, s));
+            } else if constexpr (Mode == BlendMode::SCREEN) {
+                __m256i p = _mm256_mullo_epi16(_mm256_sub_epi16(c255, d), _mm256_sub_epi16(c255, s));
+                return _mm256_sub_epi16(c255, div255_floor16(p));
+            } else if constexpr (Mode == BlendMode::OVERLAY) {
+                __m256i low = div255_floor16(_mm256_slli_epi16(_mm256_mullo_epi16(d, s), 1));
+                __m256i p = _mm256_mullo_epi16(_mm256_sub_epi16(c255, d), _mm256_sub_epi16(c255, s));
+                __m256i high = _mm256_sub_epi16(c255, div255_floor16(_mm256_slli_epi16(p, 1)));
+                __m256i is_low = _mm256_cmpgt_epi16(_mm256_set1_epi16(128), d);
+                return _mm256_blendv_epi8(high, low, is_low);
+            } else if constexpr (Mode == BlendMode::ADD) {
+                return _mm256_min_epu16(_mm256_add_epi16(d, s), c255);
+            } else {
+                return _mm256_subs_epu16(d, s);
+            }
+        }
+
+        // Separable mode on 4 pixels widened to 16 bits: coverage by src alpha, union alpha in lane 3
+        template <BlendMode Mode> inline __m256i separable_block16(__m256i d, __m256i s) {
+            const __m256i c255 = _mm256_set1_epi16(255);
+            __m256i as = broadcast_alpha16(s);
+            __m256i inv_as = _mm256_sub_epi16(c255, as);
+            __m256i mixed = separable16<Mode>(d, s);
+            __m256i color =
+                div255_round16(_mm256_add_epi16(_mm256_mullo_epi16(mixed, as), _mm256_mullo_epi16(d, inv_as)));
+            __m256i alpha = _mm256_add_epi16(as, div255_round16(_mm256_mullo_epi16(d, inv_as)));
+            return _mm256_blend_epi16(color, alpha, 0x88);
+        }
+
+        // Source-over on 4 pixels widened to 16 bits, valid when every dst alpha is 255
+        inline __m256i over_opaque_dst16(__m256i d, __m256i s) {
+            const __m256i c255 = _mm256_set1_epi16(255);
+            __m256i as = broadcast_alpha16(s);
+            __m256i color = div255_round16(
+                _mm256_add_epi16(_mm256_mullo_epi16(s, as), _mm256_mullo_epi16(d, _mm256_sub_epi16(c255, as))));
+            return _mm256_blend_epi16(color, c255, 0x88);
+        }
+
+        template <BlendMode Mode> inline __m256i premultiplied16(__m256i d, __m256i s) {
+            __m256i inv_as = _mm256_sub_epi16(_mm256_set1_epi16(255), broadcast_alpha16(s));
+            if constexpr (Mode == BlendMode::NORMAL) {
+                return _mm256_add_epi16(s, div255_round16(_mm256_mullo_epi16(d, inv_as)));
+            } else {
+                // SCREEN: s + d - s * d / 255 on all four channels
+                return _mm256_sub_epi16(_mm256_add_epi16(s, d), div255_round16(_mm256_mullo_epi16(s, d)));
+            }
+        }
+
+        // Process 8 pixels at p_src / p_dst with a 16-bit kernel
+        template <typename Kernel> inline void widen_apply(const uint8_t *p_src, uint8_t *p_dst, Kernel kernel) {
+            const __m256i zero = _mm256_setzero_si256();
+            __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p_src));
+            __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p_dst));
+            __m256i lo = kernel(_mm256_unpacklo_epi8(d, zero), _mm256_unpacklo_epi8(s, zero));
+            __m256i hi = kernel(_mm256_unpackhi_epi8(d, zero), _mm256_unpackhi_epi8(s, zero));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(p_dst), _mm256_packus_epi16(lo, hi));
+        }
+
+        // Bit i*4+3 set for every pixel i of the 8 whose byte equals `value` in the alpha position
+        inline uint32_t alpha_equal_mask(const uint8_t *p, uint8_t value) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+            __m256i eq = _mm256_cmpeq_epi8(v, _mm256_set1_epi8(static_cast<char>(value)));
+            return static_cast<uint32_t>(_mm256_movemask_epi8(eq)) & 0x88888888u;
+        }
+#endif
+
+        // Raw RGBA byte views are only valid when RGB is exactly four packed bytes
+        constexpr bool PACKED_RGB = sizeof(RGB) == 4;
+
+        inline const uint8_t *bytes(const RGB *p) { return &p->r(); }
+        inline uint8_t *bytes(RGB *p) { return &p->r(); }
+
+        template <BlendMode Mode> inline void blend_span(const RGB *src, RGB *dst, size_t n) {
+            size_t i = 0;
+#ifdef PIGMENT_SIMD_AVX2
+            if constexpr (PACKED_RGB) {
+                for (; i + 8 <= n; i += 8) {
+                    const uint8_t *s = bytes(src + i);
+                    uint8_t *d = bytes(dst + i);
+                    // Fully transparent source run: dst unchanged
+                    if (alpha_equal_mask(s, 0) == 0x88888888u) {
+                        continue;
+                    }
+                    if constexpr (Mode == BlendMode::NORMAL) {
+                        if (alpha_equal_mask(s, 255) == 0x88888888u) {
+                            std::memcpy(d, s, 32);
+                        } else if (alpha_equal_mask(d, 255) == 0x88888888u) {
+                            widen_apply(s, d, [](__m256i dv, __m256i sv) { return over_opaque_dst16(dv, sv); });
+                        } else {
+                            for (size_t j = 0; j < 8; ++j) {
+                                over(s + 4 * j, d + 4 * j);
+                            }
+                        }
+                    } else {
+                        widen_apply(s, d, [](__m256i dv, __m256i sv) { return separable_block16<Mode>(dv, sv); });
+                    }
+                }
+            }
+#endif
+            for (; i < n; ++i) {
+                pixel<Mode>(bytes(src + i), bytes(dst + i));
+            }
+        }
+
+        // Works on raw RGBA bytes so every packed 4 x uint8_t pixel type (RGB, PremulRGBA) can share it
+        template <BlendMode Mode> inline void blend_span_premultiplied(const uint8_t *src, uint8_t *dst, size_t n) {
+            size_t i = 0;
+#ifdef PIGMENT_SIMD_AVX2
+            if constexpr (Mode == BlendMode::NORMAL || Mode == BlendMode::SCREEN) {
+                for (; i + 8 <= n; i += 8) {
+                    const uint8_t *s = src + 4 * i;
+                    uint8_t *d = dst + 4 * i;
+                    if constexpr (Mode == BlendMode::NORMAL) {
+                        if (alpha_equal_mask(s, 255) == 0x88888888u) {
+                            std::memcpy(d, s, 32);
+                            continue;
+                        }
+                    }
+                    widen_apply(s, d, [](__m256i dv, __m256i sv) { return premultiplied16<Mode>(dv, sv); });
+                }
+            } else if constexpr (Mode == BlendMode::ADD) {
+                for (; i + 8 <= n; i += 8) {
+                    auto *d = reinterpret_cast<__m256i *>(dst + 4 * i);
+                    __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + 4 * i));
+                    _mm256_storeu_si256(d, _mm256_adds_epu8(_mm256_loadu_si256(d), s));
+                }
+            }
+#endif
+            for (; i < n; ++i) {
+                pixel_premultiplied<Mode>(src + 4 * i, dst + 4 * i);
+            }
+        }
+
+        template <template <BlendMode> class Op, typename... Args> inline void dispatch(BlendMode mode, Args... args) {
+            switch (mode) {
+            case BlendMode::NORMAL:
+                return Op<BlendMode::NORMAL>::run(args...);
+            case BlendMode::ADD:
+                return Op<BlendMode::ADD>::run(args...);
+            case BlendMode::SUBTRACT:
+                return Op<BlendMode::SUBTRACT>::run(args...);
+            case BlendMode::MULTIPLY:
+                return Op<BlendMode::MULTIPLY>::run(args...);
+            case BlendMode::SCREEN:
+                return Op<BlendMode::SCREEN>::run(args...);
+            case BlendMode::OVERLAY:
+                return Op<BlendMode::OVERLAY>::run(args...);
+            }
+        }
+
+        template <BlendMode Mode> struct SpanOp {
+            static void run(const RGB *src, RGB *dst, size_t n) { blend_span<Mode>(src, dst, n); }
+        };
+
+        template <BlendMode Mode> struct PremultipliedSpanOp {
+            static void run(const RGB *src, RGB *dst, size_t n) {
+                if constexpr (PACKED_RGB) {
+                    blend_span_premultiplied<Mode>(bytes(src), bytes(dst), n);
+                } else {
+                    for (size_t i = 0; i < n; ++i) {
+                        pixel_premultiplied<Mode>(bytes(src + i), bytes(dst + i));
+                    }
+                }
+            }
+        };
+
+        template <BlendMode Mode> struct PlanarOp {
+            static void run(const PlanarImage<RGB> *src, PlanarImage<RGB> *dst) {
+                uint8_t s[4], d[4];
+                for (size_t y = 0; y < src->height(); ++y) {
+                    const uint8_t *sp[4] = {src->row(0, y).data(), src->row(1, y).data(), src->row(2, y).data(),
+                                            src->row(3, y).data()};
+                    uint8_t *dp[4] = {dst->row(0, y).data(), dst->row(1, y).data(), dst->row(2, y).data(),
+                                      dst->row(3, y).data()};
+                    for (size_t x = 0; x < src->width(); ++x) {
+                        if (sp[3][x] == 0) {
+                            continue;
+                        }
+                        for (int c = 0; c < 4; ++c) {
+                            s[c] = sp[c][x];
+                            d[c] = dp[c][x];
+                        }
+                        pixel<Mode>(s, d);
+                        for (int c = 0; c < 4; ++c) {
+                            dp[c][x] = d[c];
+                        }
+                    }
+                }
+            }
+        };
+
+    } // namespace blend_detail
+
+    // Composite a single pixel: returns src blended onto dst
+    inline RGB blend(BlendMode mode, const RGB &src, const RGB &dst) {
+        RGB out = dst;
+        blend_detail::dispatch<blend_detail::SpanOp>(mode, &src, &out, size_t(1));
+        return out;
+    }
+
+    // Composite src onto dst in place (straight alpha), 8 pixels per step with AVX2
+    inline void blend(BlendMode mode, std::span<const RGB> src, std::span<RGB> dst) {
+        if (dst.size() < src.size()) {
+            throw std::invalid_argument("Destination span is smaller than source span");
+        }
+        blend_detail::dispatch<blend_detail::SpanOp>(mode, src.data(), dst.data(), src.size());
+    }
+
+    // Composite premultiplied-alpha buffers in place; only NORMAL, ADD, MULTIPLY and SCREEN have
+    // division-free premultiplied forms
+    inline void blend_premultiplied(BlendMode mode, std::span<const RGB> src, std::span<RGB> dst) {
+        if (dst.size() < src.size()) {
+            throw std::invalid_argument("Destination span is smaller than source span");
+        }
+        if (mode == BlendMode::SUBTRACT || mode == BlendMode::OVERLAY) {
+            throw std::invalid_argument("Blend mode has no premultiplied form");
+        }
+        blend_detail::dispatch<blend_detail::PremultipliedSpanOp>(mode, src.data(), dst.data(), src.size());
+    }
+
+    // Composite planar images in place; dimensions must match
+    inline void blend(BlendMode mode, const PlanarImage<RGB> &src, PlanarImage<RGB> &dst) {
+        if (src.width() != dst.width() || src.height() != dst.height()) {
+            throw std::invalid_argument("Planar images differ in size");
+        }
+        blend_detail::dispatch<blend_detail::PlanarOp>(mode, &src, &dst);
+    }
+
+} // namespace pigment
@@ -0,0 +1,144 @@
+#pragma once
+
+#include "types_basic.hpp"
+#include "types_float.hpp"
+#include "types_hsl.hpp"
+#include "types_hsv.hpp"
+#include "types_lab.hpp"
+#include "types_lch.hpp"
+#include "types_oklab.hpp"
+#include "types_xyz.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace pigment {
+
+    /**
+     * @brief Compile-time description of a color type
+     *
+     * Every specialization exposes `from_rgb` and `to_rgb`, so generic code (batch conversion, containers)
+     * can route any color type through RGB without knowing its concrete conversion functions. Types stored as a
+     * datapod vector also describe their channels (`channel_type`, `channels`, `data()` pointing at the first
+     * component) for planar containers. The float types name their double counterpart as `double_type`, with
+     * `widen` / `narrow` converting between the two.
+     */
+    template <typename T> struct color_traits;
+
+    template <> struct color_traits<RGB> {
+        using channel_type = uint8_t;
+        static constexpr size_t channels = 4;
+        static channel_type *data(RGB &c) { return &c.r(); }
+        static const channel_type *data(const RGB &c) { return &c.r(); }
+        static RGB from_rgb(const RGB &c) { return c; }
+        static RGB to_rgb(const RGB &c) { return c; }
+    };
+
+    template <> struct color_traits<MONO> {
+        using channel_type = uint8_t;
+        static constexpr size_t channels = 2;
+        static channel_type *data(MONO &c) { return &c.v(); }
+        static const channel_type *data(const MONO &c) { return &c.v(); }
+        static MONO from_rgb(const RGB &c) { return MONO(c); }
+        static RGB to_rgb(const MONO &c) { return c.to_rgb(); }
+    };
+
+    template <> struct color_traits<HSL> {
+        static HSL from_rgb(const RGB &c) { return HSL::fromRGB(c); }
+        static RGB to_rgb(const HSL &c) { return c.to_rgb(); }
+    };
+
+    template <> struct color_traits<HSV> {
+        using channel_type = float;
+        static constexpr size_t channels = 3;
+        static channel_type *data(HSV &c) { return &c.h(); }
+        static const channel_type *data(const HSV &c) { return &c.h(); }
+        static HSV from_rgb(const RGB &c) { return HSV::fromRGB(c); }
+        static RGB to_rgb(const HSV &c) { return c.to_rgb(); }
+    };
+
+    template <> struct color_traits<LAB> {
+        using channel_type = double;
+        static constexpr size_t channels = 4;
+        static channel_type *data(LAB &c) { return &c.l(); }
+        static const channel_type *data(const LAB &c) { return &c.l(); }
+        static LAB from_rgb(const RGB &c) { return LAB::fromRGB(c); }
+        static RGB to_rgb(const LAB &c) { return c.to_rgb(); }
+    };
+
+    template <> struct color_traits<LCH> {
+        using channel_type = double;
+        static constexpr size_t channels = 3;
+        static channel_type *data(LCH &c) { return &c.l(); }
+        static const channel_type *data(const LCH &c) { return &c.l(); }
+        static LCH from_rgb(const RGB &c) { return LCH::fromRGB(c); }
+        static RGB to_rgb(const LCH &c) { return c.to_rgb(); }
+    };
+
+    template <> struct color_traits<XYZ> {
+        using channel_type = double;
+        static constexpr size_t channels = 3;
+        static channel_type *data(XYZ &c) { return &c.x(); }
+        static const channel_type *data(const XYZ &c) { return &c.x(); }
+        static XYZ from_rgb(const RGB &c) { return XYZ::fromRGB(c); }
+        static RGB to_rgb(const XYZ &c) { return c.to_rgb(); }
+    };
+
+    template <> struct color_traits<OKLAB> {
+        using channel_type = double;
+        static constexpr size_t channels = 3;
+        static channel_type *data(OKLAB &c) { return &c.l(); }
+        static const channel_type *data(const OKLAB &c) { return &c.l(); }
+        static OKLAB from_rgb(const RGB &c) { return OKLAB::fromRGB(c); }
+        static RGB to_rgb(const OKLAB &c) { return c.to_rgb(); }
+    };
+
+    template <> struct color_traits<LABf> {
+        using double_type = LAB;
+        using channel_type = float;
+        static constexpr size_t channels = 4;
+        static channel_type *data(LABf &c) { return &c.l(); }
+        static const channel_type *data(const LABf &c) { return &c.l(); }
+        static LABf from_rgb(const RGB &c) { return LABf::fromRGB(c); }
+        static RGB to_rgb(const LABf &c) { return c.to_rgb(); }
+        static LAB widen(const LABf &c) { return c.to_lab(); }
+        static LABf narrow(const LAB &c) { return LABf(c); }
+    };
+
+    template <> struct color_traits<LCHf> {
+        using double_type = LCH;
+        using channel_type = float;
+        static constexpr size_t channels = 3;
+        static channel_type *data(LCHf &c) { return &c.l(); }
+        static const channel_type *data(const LCHf &c) { return &c.l(); }
+        static LCHf from_rgb(const RGB &c) { return LCHf::fromRGB(c); }
+        static RGB to_rgb(const LCHf &c) { return c.to_rgb(); }
+        static LCH widen(const LCHf &c) { return c.to_lch(); }
+        static LCHf narrow(const LCH &c) { return LCHf(c); }
+    };
+
+    template <> struct color_traits<XYZf> {
+        using double_type = XYZ;
+        using channel_type = float;
+        static constexpr size_t channels = 3;
+        static channel_type *data(XYZf &c) { return &c.x(); }
+        static const channel_type *data(const XYZf &c) { return &c.x(); }
+        static XYZf from_rgb(const RGB &c) { return XYZf::fromRGB(c); }
+        static RGB to_rgb(const XYZf &c) { return c.to_rgb(); }
+        static XYZ widen(const XYZf &c) { return c.to_xyz(); }
+        static XYZf narrow(const XYZ &c) { return XYZf(c); }
+    };
+
+    template <> struct color_traits<OKLABf> {
+        using double_type = OKLAB;
+        using channel_type = float;
+        static constexpr size_t channels = 3;
+        static channel_type *data(OKLABf &c) { return &c.l(); }
+        static const channel_type *data(const OKLABf &c) { return &c.l(); }
+        static OKLABf from_rgb(const RGB &c) { return OKLABf::fromRGB(c); }
+        static RGB to_rgb(const OKLABf &c) { return c.to_rgb(); }
+        static OKLAB widen(const OKLABf &c) { return c.to_oklab(); }
+        static OKLABf narrow(const OKLAB &c) { return OKLABf(c); }
+    };
+
+} // namespace pigment
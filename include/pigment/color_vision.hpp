@@ -0,0 +1,244 @@
+#pragma once
+
+#include "parallel.hpp"
+#include "planar.hpp"
+#include "premultiplied.hpp"
+#include "simd.hpp"
+#include "types_basic.hpp"
+#include "utils.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+
+namespace pigment {
+
+    /**
+     * @brief Color vision deficiency simulation and daltonization for whole images
+     *
+     * Every type / severity / mode collapses into one 3x3 matrix applied in linear light, so a pixel costs three
+     * gamma table reads, one vectorized matrix product and three inverse-gamma table reads. Simulation uses the
+     * Machado et al. (2009) matrices; daltonization (Fidaner et al.) shifts the simulation error onto channels
+     * the viewer can still tell apart, which is linear as well and folds into the same matrix.
+     * Alpha passes through unchanged.
+     */
+    class ColorVision {
+      public:
+        enum class Deficiency { PROTAN, DEUTAN, TRITAN };
+        enum class Mode { SIMULATE, DALTONIZE };
+
+        using Matrix = std::array<float, 9>; // row-major, linear RGB in -> linear RGB out
+
+      private:
+        Matrix matrix_{};
+
+        // Machado et al. (2009), severity 0.5 and 1.0 (row-major, linear RGB)
+        static constexpr double MACHADO_HALF[3][9] = {
+            {0.458064, 0.679578, -0.137642, 0.092785, 0.846313, 0.060902, -0.007530, -0.007880, 1.015410},
+            {0.547494, 0.607765, -0.155259, 0.181692, 0.781742, 0.036566, -0.010410, 0.027275, 0.983136},
+            {1.017277, 0.027029, -0.044306, -0.006113, 0.958479, 0.047634, 0.006379, 0.248708, 0.744913}};
+        static constexpr double MACHADO_FULL[3][9] = {
+            {0.152286, 1.052583, -0.204868, 0.114503, 0.786281, 0.099216, -0.003882, -0.048116, 1.051998},
+            {0.367322, 0.860646, -0.227968, 0.280085, 0.672501, 0.047413, -0.011820, 0.042940, 0.968881},
+            {1.255528, -0.076749, -0.178779, -0.078411, 0.930809, 0.147602, 0.004733, 0.691367, 0.303900}};
+
+        // Where the simulation error is redistributed: red-green losses go to green and blue, blue losses to red
+        // and green
+        static constexpr double ERROR_SHIFT[3][9] = {{0.0, 0.0, 0.0, 0.7, 1.0, 0.0, 0.7, 0.0, 1.0},
+                                                     {0.0, 0.0, 0.0, 0.7, 1.0, 0.0, 0.7, 0.0, 1.0},
+                                                     {1.0, 0.0, 0.7, 0.0, 1.0, 0.7, 0.0, 0.0, 0.0}};
+
+        // Severity between the published anchors is interpolated piecewise-linearly (identity at 0)
+        static std::array<double, 9> simulation(Deficiency deficiency, double severity) {
+            const double *half = MACHADO_HALF[static_cast<int>(deficiency)];
+            const double *full = MACHADO_FULL[static_cast<int>(deficiency)];
+            std::array<double, 9> m{};
+            for (int i = 0; i < 9; ++i) {
+                const double identity = (i % 4 == 0) ? 1.0 : 0.0;
+                m[i] = severity <= 0.5 ? identity + (half[i] - identity) * (severity * 2.0)
+                                       : half[i] + (full[i] - half[i]) * (severity * 2.0 - 1.0);
+            }
+            return m;
+        }
+
+        // Clamp to [0, 1] (NaN to 0) and scale to an inverse-gamma table position, rounded by the final truncation
+        template <typename L> static typename L::type table_position(typename L::type v) {
+            const auto zero = L::splat(0.0f);
+            const auto one = L::splat(1.0f);
+            v = L::select_gt(v, zero, v, zero);
+            v = L::select_gt(v, one, one, v);
+            return L::fmadd(v, L::splat(static_cast<float>(lab_tables::LINEAR_TABLE_SIZE - 1)), L::splat(0.5f));
+        }
+
+        template <typename L> void apply_block(const float (&m)[9], const RGB *src, RGB *dst) const {
+            constexpr size_t W = L::width;
+            const auto &table = premul_detail::linear_to_byte_table();
+            float r[W], g[W], b[W];
+            simd::gather_linear<W>(src, r, g, b);
+            typename L::type x, y, z;
+            simd::mat3<L>(m, L::load(r), L::load(g), L::load(b), x, y, z);
+            L::store(r, table_position<L>(x));
+            L::store(g, table_position<L>(y));
+            L::store(b, table_position<L>(z));
+            for (size_t j = 0; j < W; ++j) {
+                dst[j] = RGB(table[static_cast<size_t>(r[j])], table[static_cast<size_t>(g[j])],
+                             table[static_cast<size_t>(b[j])], src[j].a());
+            }
+        }
+
+        template <typename L>
+        void apply_planes_block(const float (&m)[9], uint8_t *r_io, uint8_t *g_io, uint8_t *b_io) const {
+            constexpr size_t W = L::width;
+            const auto &table = premul_detail::linear_to_byte_table();
+            float r[W], g[W], b[W];
+            for (size_t j = 0; j < W; ++j) {
+                r[j] = lab_tables::gamma_to_linear_f[r_io[j]];
+                g[j] = lab_tables::gamma_to_linear_f[g_io[j]];
+                b[j] = lab_tables::gamma_to_linear_f[b_io[j]];
+            }
+            typename L::type x, y, z;
+            simd::mat3<L>(m, L::load(r), L::load(g), L::load(b), x, y, z);
+            L::store(r, table_position<L>(x));
+            L::store(g, table_position<L>(y));
+            L::store(b, table_position<L>(z));
+            for (size_t j = 0; j < W; ++j) {
+                r_io[j] = table[static_cast<size_t>(r[j])];
+                g_io[j] = table[static_cast<size_t>(g[j])];
+                b_io[j] = table[static_cast<size_t>(b[j])];
+            }
+        }
+
+        // The tail is padded to a full block so every pixel takes the same arithmetic (and rounding) path
+        void apply_span(const RGB *src, RGB *dst, size_t n) const {
+            float m[9];
+            std::copy(matrix_.begin(), matrix_.end(), m);
+            constexpr size_t W = simd::NativeLanes::width;
+            size_t i = 0;
+            for (; i + W <= n; i += W) {
+                apply_block<simd::NativeLanes>(m, src + i, dst + i);
+            }
+            if constexpr (W > 1) {
+                if (i < n) {
+                    RGB block[W];
+                    std::copy(src + i, src + n, block);
+                    apply_block<simd::NativeLanes>(m, block, block);
+                    std::copy(block, block + (n - i), dst + i);
+                }
+            }
+        }
+
+      public:
+        // Identity filter
+        ColorVision() : matrix_{1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f} {}
+
+        // `severity` runs from 0 (normal vision) to 1 (dichromacy: protanopia, deuteranopia, tritanopia)
+        explicit ColorVision(Deficiency deficiency, double severity = 1.0, Mode mode = Mode::SIMULATE) {
+            if (!(severity >= 0.0 && severity <= 1.0)) {
+                throw std::invalid_argument("Color vision deficiency severity must be in [0, 1]");
+            }
+            const std::array<double, 9> sim = simulation(deficiency, severity);
+            if (mode == Mode::SIMULATE) {
+                for (int i = 0; i < 9; ++i) {
+                    matrix_[i] = static_cast<float>(sim[i]);
+                }
+                return;
+            }
+            // out = in + E * (in - S * in) = (I + E * (I - S)) * in
+            const double *shift = ERROR_SHIFT[static_cast<int>(deficiency)];
+            for (int row = 0; row < 3; ++row) {
+                for (int col = 0; col < 3; ++col) {
+                    double sum = (row == col) ? 1.0 : 0.0;
+                    for (int k = 0; k < 3; ++k) {
+                        const double loss = ((k == col) ? 1.0 : 0.0) - sim[k * 3 + col];
+                        sum += shift[row * 3 + k] * loss;
+                    }
+                    matrix_[row * 3 + col] = static_cast<float>(sum);
+                }
+            }
+        }
+
+        // Same deficiency as the legacy utils::ColorBlindness types; the *ANOMALY types map to severity 0.5
+        static ColorVision from_type(utils::ColorBlindness::Type type, Mode mode = Mode::SIMULATE) {
+            switch (type) {
+            case utils::ColorBlindness::PROTANOPIA:
+                return ColorVision(Deficiency::PROTAN, 1.0, mode);
+            case utils::ColorBlindness::DEUTERANOPIA:
+                return ColorVision(Deficiency::DEUTAN, 1.0, mode);
+            case utils::ColorBlindness::TRITANOPIA:
+                return ColorVision(Deficiency::TRITAN, 1.0, mode);
+            case utils::ColorBlindness::PROTANOMALY:
+                return ColorVision(Deficiency::PROTAN, 0.5, mode);
+            case utils::ColorBlindness::DEUTERANOMALY:
+                return ColorVision(Deficiency::DEUTAN, 0.5, mode);
+            case utils::ColorBlindness::TRITANOMALY:
+                return ColorVision(Deficiency::TRITAN, 0.5, mode);
+            }
+            throw std::invalid_argument("Unknown color blindness type");
+        }
+
+        const Matrix &matrix() const { return matrix_; }
+
+        // Single pixel
+        RGB apply(const RGB &color) const {
+            RGB out;
+            apply_span(&color, &out, 1);
+            return out;
+        }
+
+        // Batch; `dst` may alias `src`
+        void apply(std::span<const RGB> src, std::span<RGB> dst) const {
+            PIGMENT_SCOPE_N("ColorVision::apply", src.size());
+            if (dst.size() < src.size()) {
+                throw std::invalid_argument("Destination span is smaller than source span");
+            }
+            apply_span(src.data(), dst.data(), src.size());
+        }
+
+        // Tiled batch for large buffers
+        template <typename Executor>
+        void apply(std::span<const RGB> src, std::span<RGB> dst, Executor &&executor,
+                   size_t tile_size = parallel::DEFAULT_TILE_SIZE) const {
+            PIGMENT_SCOPE_N("ColorVision::apply", src.size());
+            if (dst.size() < src.size()) {
+                throw std::invalid_argument("Destination span is smaller than source span");
+            }
+            parallel::for_each_tile(
+                src.size(), executor,
+                [&](size_t begin, size_t end) { apply_span(src.data() + begin, dst.data() + begin, end - begin); },
+                tile_size);
+        }
+
+        // In-place over the r, g, b planes (alpha plane untouched)
+        void apply(PlanarImage<RGB> &image) const {
+            float m[9];
+            std::copy(matrix_.begin(), matrix_.end(), m);
+            constexpr size_t W = simd::NativeLanes::width;
+            for (size_t y = 0; y < image.height(); ++y) {
+                uint8_t *r = image.row(0, y).data();
+                uint8_t *g = image.row(1, y).data();
+                uint8_t *b = image.row(2, y).data();
+                size_t x = 0;
+                for (; x + W <= image.width(); x += W) {
+                    apply_planes_block<simd::NativeLanes>(m, r + x, g + x, b + x);
+                }
+                if constexpr (W > 1) {
+                    if (x < image.width()) {
+                        const size_t rest = image.width() - x;
+                        uint8_t block[3][W] = {};
+                        std::copy(r + x, r + x + rest, block[0]);
+                        std::copy(g + x, g + x + rest, block[1]);
+                        std::copy(b + x, b + x + rest, block[2]);
+                        apply_planes_block<simd::NativeLanes>(m, block[0], block[1], block[2]);
+                        std::copy(block[0], block[0] + rest, r + x);
+                        std::copy(block[1], block[1] + rest, g + x);
+                        std::copy(block[2], block[2] + rest, b + x);
+                    }
+                }
+            }
+        }
+    };
+
+} // namespace pigment
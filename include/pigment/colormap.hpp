@@ -0,0 +1,204 @@
+#pragma once
+
+#include "parallel.hpp"
+#include "types_basic.hpp"
+#include "types_lab.hpp"
+#include "types_oklab.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace pigment {
+
+    /**
+     * @brief Precomputed gradient ramp for mapping scalars to colors
+     *
+     * The gradient through the stops is evaluated once into a fixed-size ramp (interpolated in RGB, linear RGB or
+     * OKLAB), so sample() is a clamp, a multiply and a table read no matter how many stops there are. map()
+     * applies the same lookup to float / double buffers, optionally tiled over an executor.
+     */
+    class Colormap {
+      public:
+        enum class Space { RGB, LINEAR_RGB, OKLAB };
+
+        // Common ramp sizes; 256 already resolves every step of an 8-bit channel between two stops
+        static constexpr size_t SMALL = 256;
+        static constexpr size_t MEDIUM = 1024;
+        static constexpr size_t LARGE = 4096;
+
+        struct Stop {
+            double position; // in [0, 1], non-decreasing
+            RGB color;
+        };
+
+      private:
+        std::vector<RGB> ramp_;
+        float scale_ = 0.0f; // ramp_.size() - 1
+
+        static double lerp(double a, double b, double t) { return a + (b - a) * t; }
+
+        static uint8_t to_byte(double v) { return static_cast<uint8_t>(std::clamp(std::lround(v), 0L, 255L)); }
+
+        static RGB interpolate(const RGB &a, const RGB &b, double t, Space space) {
+            const uint8_t alpha = to_byte(lerp(a.a(), b.a(), t));
+            if (space == Space::OKLAB) {
+                OKLAB la = OKLAB::fromRGB(a), lb = OKLAB::fromRGB(b);
+                RGB mixed = OKLAB(lerp(la.l(), lb.l(), t), lerp(la.a(), lb.a(), t), lerp(la.b(), lb.b(), t)).to_rgb();
+                return mixed.with_alpha(alpha);
+            }
+            if (space == Space::LINEAR_RGB) {
+                auto channel = [t](uint8_t ca, uint8_t cb) {
+                    double linear = lerp(lab_tables::gamma_to_linear[ca], lab_tables::gamma_to_linear[cb], t);
+                    return to_byte(lab_tables::exact_linear_to_gamma(linear) * 255.0);
+                };
+                return RGB(channel(a.r(), b.r()), channel(a.g(), b.g()), channel(a.b(), b.b()), alpha);
+            }
+            return RGB(to_byte(lerp(a.r(), b.r(), t)), to_byte(lerp(a.g(), b.g(), t)), to_byte(lerp(a.b(), b.b(), t)),
+                       alpha);
+        }
+
+        void build(std::span<const Stop> stops, size_t size, Space space) {
+            if (stops.empty()) {
+                throw std::invalid_argument("Colormap needs at least one stop");
+            }
+            if (size < 2) {
+                throw std::invalid_argument("Colormap size must be at least 2");
+            }
+            for (size_t i = 1; i < stops.size(); ++i) {
+                if (stops[i].position < stops[i - 1].position) {
+                    throw std::invalid_argument("Colormap stops must be sorted by position");
+                }
+            }
+
+            ramp_.resize(size);
+            scale_ = static_cast<float>(size - 1);
+            size_t segment = 0;
+            for (size_t i = 0; i < size; ++i) {
+                const double t = static_cast<double>(i) / (size - 1);
+                if (t <= stops.front().position) {
+                    ramp_[i] = stops.front().color;
+                    continue;
+                }
+                if (t >= stops.back().position) {
+                    ramp_[i] = stops.back().color;
+                    continue;
+                }
+                while (stops[segment + 1].position < t) {
+                    ++segment;
+                }
+                const Stop &a = stops[segment];
+                const Stop &b = stops[segment + 1];
+                const double width = b.position - a.position;
+                ramp_[i] = interpolate(a.color, b.color, width > 0.0 ? (t - a.position) / width : 1.0, space);
+            }
+        }
+
+        // Ramp index for t in [0, 1]; NaN maps to the first entry
+        size_t index(float t) const {
+            float x = t * scale_ + 0.5f;
+            x = x > 0.0f ? x : 0.0f;
+            x = x < scale_ ? x : scale_;
+            return static_cast<size_t>(x);
+        }
+
+      public:
+        Colormap() = default;
+
+        // Evenly spaced stops
+        explicit Colormap(std::span<const RGB> colors, size_t size = MEDIUM, Space space = Space::OKLAB) {
+            std::vector<Stop> stops;
+            stops.reserve(colors.size());
+            for (size_t i = 0; i < colors.size(); ++i) {
+                stops.push_back({colors.size() > 1 ? static_cast<double>(i) / (colors.size() - 1) : 0.0, colors[i]});
+            }
+            build(stops, size, space);
+        }
+
+        explicit Colormap(const std::vector<RGB> &colors, size_t size = MEDIUM, Space space = Space::OKLAB)
+            : Colormap(std::span<const RGB>(colors), size, space) {}
+
+        // Explicitly positioned stops; t outside the first / last stop takes that stop's color
+        explicit Colormap(std::span<const Stop> stops, size_t size = MEDIUM, Space space = Space::OKLAB) {
+            build(stops, size, space);
+        }
+
+        size_t size() const { return ramp_.size(); }
+        bool empty() const { return ramp_.empty(); }
+        std::span<const RGB> ramp() const { return ramp_; }
+
+        // Nearest ramp entry for t, clamped to [0, 1]
+        const RGB &sample(double t) const {
+            if (empty()) {
+                throw std::invalid_argument("Cannot sample an empty colormap");
+            }
+            return ramp_[index(static_cast<float>(t))];
+        }
+
+        const RGB &operator()(double t) const { return sample(t); }
+
+        // Map values in [lo, hi] to colors; values outside the range clamp to the ends
+        void map(std::span<const float> values, std::span<RGB> out, float lo = 0.0f, float hi = 1.0f) const {
+            map_values(values, out, lo, hi);
+        }
+
+        void map(std::span<const double> values, std::span<RGB> out, double lo = 0.0, double hi = 1.0) const {
+            map_values(values, out, lo, hi);
+        }
+
+        // Tiled variants for large buffers
+        template <typename Executor>
+        void map(std::span<const float> values, std::span<RGB> out, float lo, float hi, Executor &&executor,
+                 size_t tile_size = parallel::DEFAULT_TILE_SIZE) const {
+            map_tiled(values, out, lo, hi, executor, tile_size);
+        }
+
+        template <typename Executor>
+        void map(std::span<const double> values, std::span<RGB> out, double lo, double hi, Executor &&executor,
+                 size_t tile_size = parallel::DEFAULT_TILE_SIZE) const {
+            map_tiled(values, out, lo, hi, executor, tile_size);
+        }
+
+      private:
+        template <typename T> void map_values(std::span<const T> values, std::span<RGB> out, T lo, T hi) const {
+            if (out.size() < values.size()) {
+                throw std::invalid_argument("Destination span is smaller than source span");
+            }
+            if (empty()) {
+                throw std::invalid_argument("Cannot map through an empty colormap");
+            }
+            // Fold the range normalization into a single multiply-add per value
+            const float scale = hi != lo ? scale_ / static_cast<float>(hi - lo) : 0.0f;
+            const float bias = 0.5f - static_cast<float>(lo) * scale;
+            const RGB *ramp = ramp_.data();
+            const float top = scale_;
+            for (size_t i = 0; i < values.size(); ++i) {
+                float x = static_cast<float>(values[i]) * scale + bias;
+                x = x > 0.0f ? x : 0.0f; // also sends NaN to the first entry
+                x = x < top ? x : top;
+                out[i] = ramp[static_cast<size_t>(x)];
+            }
+        }
+
+        template <typename T, typename Executor>
+        void map_tiled(std::span<const T> values, std::span<RGB> out, T lo, T hi, Executor &executor,
+                       size_t tile_size) const {
+            if (out.size() < values.size()) {
+                throw std::invalid_argument("Destination span is smaller than source span");
+            }
+            if (empty()) {
+                throw std::invalid_argument("Cannot map through an empty colormap");
+            }
+            parallel::for_each_tile(
+                values.size(), executor,
+                [&](size_t begin, size_t end) {
+                    map_values(values.subspan(begin, end - begin), out.subspan(begin, end - begin), lo, hi);
+                },
+                tile_size);
+        }
+    };
+
+} // namespace pigment
@@ -0,0 +1,184 @@
+#pragma once
+
+#include "parallel.hpp"
+#include "types_basic.hpp"
+#include "types_lab.hpp"
+#include "utils.hpp"
+
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace pigment {
+
+    namespace contrast {
+
+        // WCAG 2.x relative luminance (linear-light Rec. 709 weights), 0 for black to 1 for white
+        inline double relative_luminance(const RGB &color) {
+            return 0.2126 * lab_tables::gamma_to_linear[color.r()] + 0.7152 * lab_tables::gamma_to_linear[color.g()] +
+                   0.0722 * lab_tables::gamma_to_linear[color.b()];
+        }
+
+        // WCAG contrast ratio between two relative luminances, 1 to 21 regardless of order
+        inline double ratio(double luminance1, double luminance2) {
+            if (luminance1 < luminance2) {
+                std::swap(luminance1, luminance2);
+            }
+            return (luminance1 + 0.05) / (luminance2 + 0.05);
+        }
+
+        inline double ratio(const RGB &color1, const RGB &color2) {
+            return ratio(relative_luminance(color1), relative_luminance(color2));
+        }
+
+        // Minimum ratio a level asks for (1 for FAIL, i.e. everything passes)
+        inline double required_ratio(utils::AccessibilityLevel::Level level) {
+            switch (level) {
+            case utils::AccessibilityLevel::AA_LARGE:
+                return 3.0;
+            case utils::AccessibilityLevel::AA_NORMAL:
+            case utils::AccessibilityLevel::AAA_LARGE:
+                return 4.5;
+            case utils::AccessibilityLevel::AAA_NORMAL:
+                return 7.0;
+            case utils::AccessibilityLevel::FAIL:
+                break;
+            }
+            return 1.0;
+        }
+
+        // Highest level a ratio reaches, with the same precedence as utils::check_accessibility
+        inline utils::AccessibilityLevel::Level level(double contrast_ratio, bool large_text = false) {
+            if (contrast_ratio >= 7.0)
+                return utils::AccessibilityLevel::AAA_NORMAL;
+            if (contrast_ratio >= 4.5) {
+                return large_text ? utils::AccessibilityLevel::AAA_LARGE : utils::AccessibilityLevel::AA_NORMAL;
+            }
+            if (contrast_ratio >= 3.0 && large_text)
+                return utils::AccessibilityLevel::AA_LARGE;
+            return utils::AccessibilityLevel::FAIL;
+        }
+
+    } // namespace contrast
+
+    /**
+     * @brief All-pairs WCAG contrast table over a palette
+     *
+     * Relative luminance is read from the gamma table once per color; the N x N ratios are then two adds and a
+     * divide each. Pass/fail queries are answered from the double luminances, not the float table, so a pair
+     * sitting right at 4.5 is judged exactly the way contrast::ratio judges it.
+     */
+    class ContrastMatrix {
+      private:
+        std::vector<RGB> colors_;
+        std::vector<double> luminance_;
+        std::vector<float> ratios_; // row-major, size() x size()
+
+        void build_row(size_t i) {
+            const size_t n = colors_.size();
+            float *row = ratios_.data() + i * n;
+            for (size_t j = 0; j < n; ++j) {
+                row[j] = static_cast<float>(contrast::ratio(luminance_[i], luminance_[j]));
+            }
+        }
+
+        template <typename Executor> void build(Executor &executor) {
+            PIGMENT_SCOPE_N("ContrastMatrix::build", colors_.size());
+            const size_t n = colors_.size();
+            luminance_.resize(n);
+            for (size_t i = 0; i < n; ++i) {
+                luminance_[i] = contrast::relative_luminance(colors_[i]);
+            }
+            ratios_.resize(n * n);
+            executor(n, [this](size_t i) { build_row(i); });
+        }
+
+        void check_index(size_t i) const {
+            if (i >= colors_.size()) {
+                throw std::out_of_range("Contrast matrix index out of range");
+            }
+        }
+
+      public:
+        ContrastMatrix() = default;
+
+        explicit ContrastMatrix(std::span<const RGB> palette) : colors_(palette.begin(), palette.end()) {
+            parallel::SerialExecutor executor;
+            build(executor);
+        }
+
+        explicit ContrastMatrix(const std::vector<RGB> &palette) : ContrastMatrix(std::span<const RGB>(palette)) {}
+
+        // Rows are filled in parallel
+        template <typename Executor>
+        ContrastMatrix(std::span<const RGB> palette, Executor &&executor) : colors_(palette.begin(), palette.end()) {
+            build(executor);
+        }
+
+        size_t size() const { return colors_.size(); }
+        bool empty() const { return colors_.empty(); }
+        const std::vector<RGB> &colors() const { return colors_; }
+        const std::vector<double> &luminance() const { return luminance_; }
+
+        // Full table, row-major: ratio(i, j) is table()[i * size() + j]
+        std::span<const float> table() const { return ratios_; }
+
+        std::span<const float> row(size_t i) const {
+            check_index(i);
+            return std::span<const float>(ratios_).subspan(i * colors_.size(), colors_.size());
+        }
+
+        float operator()(size_t i, size_t j) const { return ratios_[i * colors_.size() + j]; }
+
+        double ratio(size_t i, size_t j) const {
+            check_index(i);
+            check_index(j);
+            return contrast::ratio(luminance_[i], luminance_[j]);
+        }
+
+        utils::AccessibilityLevel::Level level(size_t foreground, size_t background, bool large_text = false) const {
+            return contrast::level(ratio(foreground, background), large_text);
+        }
+
+        // Indices of the palette colors that reach `level` against an arbitrary background
+        std::vector<size_t> passing(const RGB &background, utils::AccessibilityLevel::Level level) const {
+            return passing_luminance(contrast::relative_luminance(background), level);
+        }
+
+        // Same against a palette entry (the entry itself never passes unless `level` is FAIL)
+        std::vector<size_t> passing(size_t background, utils::AccessibilityLevel::Level level) const {
+            check_index(background);
+            return passing_luminance(luminance_[background], level);
+        }
+
+        // Palette entry with the highest contrast against `background` (lowest index on ties)
+        size_t best_contrast(size_t background) const {
+            check_index(background);
+            size_t best = 0;
+            double best_ratio = 0.0;
+            for (size_t j = 0; j < colors_.size(); ++j) {
+                double r = contrast::ratio(luminance_[background], luminance_[j]);
+                if (r > best_ratio) {
+                    best_ratio = r;
+                    best = j;
+                }
+            }
+            return best;
+        }
+
+      private:
+        std::vector<size_t> passing_luminance(double background, utils::AccessibilityLevel::Level level) const {
+            const double required = contrast::required_ratio(level);
+            std::vector<size_t> result;
+            for (size_t j = 0; j < colors_.size(); ++j) {
+                if (contrast::ratio(background, luminance_[j]) >= required) {
+                    result.push_back(j);
+                }
+            }
+            return result;
+        }
+    };
+
+} // namespace pigment
@@ -0,0 +1,178 @@
+#pragma once
+
+#include "color_traits.hpp"
+#include "mapped_file.hpp"
+#include "parallel.hpp"
+#include "types_basic.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace pigment {
+
+    /**
+     * @brief Exact RGB -> T lookup over the full 24-bit input domain
+     *
+     * Only 2^24 distinct RGB inputs exist, so every conversion result can be stored and looked up by the packed
+     * 0xRRGGBB key. Entries are grouped in pages of 4096 (one red value, 16 green values, every blue) that are
+     * converted on first access, so a cache only used for a few palettes stays small. Values are produced by
+     * color_traits<T>::from_rgb (identical to T::fromRGB); alpha is not part of the key and cached entries use
+     * opaque alpha.
+     *
+     * Lookups and lazy fills are thread-safe. A fully populated cache can be written with save() and opened
+     * again memory-mapped, which makes start-up free and shares pages between processes.
+     */
+    template <typename T> class ConversionCache {
+      public:
+        static constexpr uint32_t ENTRIES = 1u << 24;
+        static constexpr uint32_t PAGE_BITS = 12;
+        static constexpr uint32_t PAGE_SIZE = 1u << PAGE_BITS;
+        static constexpr uint32_t PAGE_COUNT = ENTRIES / PAGE_SIZE;
+
+      private:
+        struct FileHeader {
+            char magic[4];
+            uint32_t version;
+            uint32_t entry_size;
+            uint32_t entries;
+        };
+        static constexpr uint32_t FILE_VERSION = 1;
+
+        mutable std::array<std::atomic<T *>, PAGE_COUNT> pages_{};
+        MappedFile mapped_;
+
+        static uint32_t key(const RGB &color) {
+            return (static_cast<uint32_t>(color.r()) << 16) | (static_cast<uint32_t>(color.g()) << 8) | color.b();
+        }
+
+        T *fill_page(uint32_t page) const {
+            T *entries = new T[PAGE_SIZE];
+            const uint32_t base = page << PAGE_BITS;
+            for (uint32_t i = 0; i < PAGE_SIZE; ++i) {
+                const uint32_t k = base + i;
+                entries[i] = color_traits<T>::from_rgb(RGB((k >> 16) & 0xFF, (k >> 8) & 0xFF, k & 0xFF));
+            }
+            // Another thread may have filled the same page meanwhile; keep whichever landed first
+            T *expected = nullptr;
+            if (!pages_[page].compare_exchange_strong(expected, entries, std::memory_order_acq_rel)) {
+                delete[] entries;
+                return expected;
+            }
+            return entries;
+        }
+
+        bool owns_pages() const { return !mapped_.is_open(); }
+
+      public:
+        ConversionCache() = default;
+
+        // Open a cache previously written with save(); the file is mapped read-only
+        explicit ConversionCache(const std::string &path) : mapped_(path) {
+            static_assert(std::is_trivially_copyable_v<T>, "Mapped caches need a trivially copyable color type");
+            FileHeader header;
+            if (mapped_.size() < sizeof(header)) {
+                throw std::runtime_error("Conversion cache file is truncated: " + path);
+            }
+            std::memcpy(&header, mapped_.data(), sizeof(header));
+            if (std::memcmp(header.magic, "PGMC", 4) != 0 || header.version != FILE_VERSION ||
+                header.entry_size != sizeof(T) || header.entries != ENTRIES ||
+                mapped_.size() < sizeof(header) + static_cast<size_t>(ENTRIES) * sizeof(T)) {
+                throw std::runtime_error("Conversion cache file does not match this color type: " + path);
+            }
+            // Header is 16 bytes, so entries stay aligned for every color type
+            T *entries = reinterpret_cast<T *>(const_cast<uint8_t *>(mapped_.data() + sizeof(header)));
+            for (uint32_t page = 0; page < PAGE_COUNT; ++page) {
+                pages_[page].store(entries + (static_cast<size_t>(page) << PAGE_BITS), std::memory_order_relaxed);
+            }
+        }
+
+        ConversionCache(const ConversionCache &) = delete;
+        ConversionCache &operator=(const ConversionCache &) = delete;
+
+        ~ConversionCache() {
+            if (owns_pages()) {
+                for (auto &page : pages_) {
+                    delete[] page.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        // Cached conversion of `color`, filling its page on first use
+        const T &get(const RGB &color) const {
+            const uint32_t k = key(color);
+            const uint32_t page = k >> PAGE_BITS;
+            T *entries = pages_[page].load(std::memory_order_acquire);
+            if (!entries) {
+                entries = fill_page(page);
+            }
+            return entries[k & (PAGE_SIZE - 1)];
+        }
+
+        const T &operator()(const RGB &color) const { return get(color); }
+
+        // Batch lookup
+        void get(std::span<const RGB> src, std::span<T> dst) const {
+            if (dst.size() < src.size()) {
+                throw std::invalid_argument("Destination span is smaller than source span");
+            }
+            for (size_t i = 0; i < src.size(); ++i) {
+                dst[i] = get(src[i]);
+            }
+        }
+
+        // Populate every page using `threads` workers (0 = hardware concurrency)
+        void fill(size_t threads = 0) const { fill(parallel::ThreadExecutor(threads)); }
+
+        // Populate every page on a caller-provided executor, one task per page
+        template <typename Executor>
+            requires(!std::is_integral_v<std::remove_cvref_t<Executor>>)
+        void fill(Executor &&executor) const {
+            executor(PAGE_COUNT, [this](size_t page) {
+                if (!pages_[page].load(std::memory_order_acquire)) {
+                    fill_page(static_cast<uint32_t>(page));
+                }
+            });
+        }
+
+        // Number of pages converted (or mapped) so far
+        size_t pages_filled() const {
+            size_t count = 0;
+            for (const auto &page : pages_) {
+                count += page.load(std::memory_order_relaxed) != nullptr;
+            }
+            return count;
+        }
+
+        bool is_mapped() const { return mapped_.is_open(); }
+
+        // Write the fully populated cache to `path` (fills missing pages first)
+        void save(const std::string &path, size_t threads = 0) const {
+            static_assert(std::is_trivially_copyable_v<T>, "Saved caches need a trivially copyable color type");
+            fill(threads);
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            if (!out) {
+                throw std::runtime_error("Cannot open file for writing: " + path);
+            }
+            FileHeader header{{'P', 'G', 'M', 'C'}, FILE_VERSION, static_cast<uint32_t>(sizeof(T)), ENTRIES};
+            out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            for (const auto &page : pages_) {
+                out.write(reinterpret_cast<const char *>(page.load(std::memory_order_acquire)),
+                          static_cast<std::streamsize>(PAGE_SIZE * sizeof(T)));
+            }
+            if (!out) {
+                throw std::runtime_error("Failed writing conversion cache: " + path);
+            }
+        }
+    };
+
+} // namespace pigment
@@ -0,0 +1,138 @@
+#pragma once
+
+#include "color_traits.hpp"
+#include "simd.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+namespace pigment {
+
+    namespace batch_detail {
+
+        template <typename From, typename To> inline void check_sizes(std::span<const From> src, std::span<To> dst) {
+            if (dst.size() < src.size()) {
+                throw std::invalid_argument("Destination span is smaller than source span");
+            }
+        }
+
+        // True when F is the float variant of D (LABf of LAB, ...)
+        template <typename F, typename D> constexpr bool is_float_of() {
+            if constexpr (requires { typename color_traits<F>::double_type; }) {
+                return std::is_same_v<typename color_traits<F>::double_type, D>;
+            } else {
+                return false;
+            }
+        }
+
+        // Convert a single element, taking the shortest route available for the pair
+        template <typename From, typename To> inline To convert_one(const From &c) {
+            if constexpr (std::is_same_v<From, To>) {
+                return c;
+            } else if constexpr (is_float_of<To, From>()) {
+                return color_traits<To>::narrow(c);
+            } else if constexpr (is_float_of<From, To>()) {
+                return color_traits<From>::widen(c);
+            } else if constexpr (std::is_same_v<From, RGB>) {
+                return color_traits<To>::from_rgb(c);
+            } else if constexpr (std::is_same_v<To, RGB>) {
+                return color_traits<From>::to_rgb(c);
+            } else if constexpr (std::is_same_v<From, LAB> && std::is_same_v<To, LCH>) {
+                return LCH::fromLAB(c);
+            } else if constexpr (std::is_same_v<From, LCH> && std::is_same_v<To, LAB>) {
+                return c.to_lab();
+            } else if constexpr (std::is_same_v<From, LABf> && std::is_same_v<To, LCHf>) {
+                return LCHf::fromLAB(c);
+            } else if constexpr (std::is_same_v<From, LCHf> && std::is_same_v<To, LABf>) {
+                return c.to_lab();
+            } else {
+                return color_traits<To>::from_rgb(color_traits<From>::to_rgb(c));
+            }
+        }
+
+        // Tight loop over contiguous buffers; this is the scalar kernel every batch entry point falls back to
+        template <typename From, typename To> inline void convert_loop(std::span<const From> src, std::span<To> dst) {
+            PIGMENT_SCOPE_N("convert", src.size());
+            check_sizes(src, dst);
+            const From *in = src.data();
+            To *out = dst.data();
+            const size_t n = src.size();
+            for (size_t i = 0; i < n; ++i) {
+                out[i] = convert_one<From, To>(in[i]);
+            }
+        }
+
+    } // namespace batch_detail
+
+    // Batch conversion from RGB. `dst` must hold at least `src.size()` elements; only that prefix is written.
+    inline void convert(std::span<const RGB> src, std::span<MONO> dst) { batch_detail::convert_loop(src, dst); }
+    inline void convert(std::span<const RGB> src, std::span<HSL> dst) { batch_detail::convert_loop(src, dst); }
+    inline void convert(std::span<const RGB> src, std::span<HSV> dst) { batch_detail::convert_loop(src, dst); }
+    inline void convert(std::span<const RGB> src, std::span<LCH> dst) { batch_detail::convert_loop(src, dst); }
+
+    // RGB -> LAB / XYZ / OKLAB run on the float kernels in simd.hpp (AVX2, SSE4.1 or NEON, scalar lanes otherwise).
+    // They evaluate the exact cube root instead of the truncating lab_f table, so results can differ slightly from
+    // the scalar fromRGB functions.
+    inline void convert(std::span<const RGB> src, std::span<LAB> dst) {
+        PIGMENT_SCOPE_N("convert", src.size());
+        batch_detail::check_sizes(src, dst);
+        simd::rgb_to_lab(src.data(), dst.data(), src.size());
+    }
+
+    inline void convert(std::span<const RGB> src, std::span<XYZ> dst) {
+        PIGMENT_SCOPE_N("convert", src.size());
+        batch_detail::check_sizes(src, dst);
+        simd::rgb_to_xyz(src.data(), dst.data(), src.size());
+    }
+
+    inline void convert(std::span<const RGB> src, std::span<OKLAB> dst) {
+        PIGMENT_SCOPE_N("convert", src.size());
+        batch_detail::check_sizes(src, dst);
+        simd::rgb_to_oklab(src.data(), dst.data(), src.size());
+    }
+
+    // Single-precision targets: LABf / XYZf / OKLABf are written straight from the float kernels
+    inline void convert(std::span<const RGB> src, std::span<LABf> dst) {
+        PIGMENT_SCOPE_N("convert", src.size());
+        batch_detail::check_sizes(src, dst);
+        simd::rgb_to_lab(src.data(), dst.data(), src.size());
+    }
+
+    inline void convert(std::span<const RGB> src, std::span<XYZf> dst) {
+        PIGMENT_SCOPE_N("convert", src.size());
+        batch_detail::check_sizes(src, dst);
+        simd::rgb_to_xyz(src.data(), dst.data(), src.size());
+    }
+
+    inline void convert(std::span<const RGB> src, std::span<OKLABf> dst) {
+        PIGMENT_SCOPE_N("convert", src.size());
+        batch_detail::check_sizes(src, dst);
+        simd::rgb_to_oklab(src.data(), dst.data(), src.size());
+    }
+
+    inline void convert(std::span<const RGB> src, std::span<LCHf> dst) { batch_detail::convert_loop(src, dst); }
+
+    // Batch conversion back to RGB
+    inline void convert(std::span<const MONO> src, std::span<RGB> dst) { batch_detail::convert_loop(src, dst); }
+    inline void convert(std::span<const HSL> src, std::span<RGB> dst) { batch_detail::convert_loop(src, dst); }
+    inline void convert(std::span<const HSV> src, std::span<RGB> dst) { batch_detail::convert_loop(src, dst); }
+    inline void convert(std::span<const LAB> src, std::span<RGB> dst) { batch_detail::convert_loop(src, dst); }
+    inline void convert(std::span<const LCH> src, std::span<RGB> dst) { batch_detail::convert_loop(src, dst); }
+    inline void convert(std::span<const XYZ> src, std::span<RGB> dst) { batch_detail::convert_loop(src, dst); }
+    inline void convert(std::span<const OKLAB> src, std::span<RGB> dst) { batch_detail::convert_loop(src, dst); }
+    inline void convert(std::span<const LABf> src, std::span<RGB> dst) { batch_detail::convert_loop(src, dst); }
+    inline void convert(std::span<const LCHf> src, std::span<RGB> dst) { batch_detail::convert_loop(src, dst); }
+    inline void convert(std::span<const XYZf> src, std::span<RGB> dst) { batch_detail::convert_loop(src, dst); }
+    inline void convert(std::span<const OKLABf> src, std::span<RGB> dst) { batch_detail::convert_loop(src, dst); }
+
+    // Batch conversion between any other pair of color types (float <-> double and LAB <-> LCH directly, everything
+    // else via RGB).
+    // Call with explicit spans, e.g. convert(std::span<const HSL>(hsl), std::span<OKLAB>(oklab)).
+    template <typename From, typename To> inline void convert(std::span<const From> src, std::span<To> dst) {
+        batch_detail::convert_loop(src, dst);
+    }
+
+} // namespace pigment
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "types_lab.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+
+namespace pigment {
+
+    // Batch color-difference kernels: one reference against many colors, or element-wise pairs.
+    // Results match the LAB member functions exactly.
+
+    namespace delta_e_detail {
+        template <typename Fn> inline void one_to_many(std::span<const LAB> colors, std::span<double> out, Fn fn) {
+            if (out.size() < colors.size()) {
+                throw std::invalid_argument("Destination span is smaller than source span");
+            }
+            for (size_t i = 0; i < colors.size(); ++i) {
+                out[i] = fn(colors[i]);
+            }
+        }
+    } // namespace delta_e_detail
+
+    // CIE76 distance of every color to `reference`
+    inline void delta_e_76(const LAB &reference, std::span<const LAB> colors, std::span<double> out) {
+        delta_e_detail::one_to_many(colors, out, [&](const LAB &c) { return reference.delta_e(c); });
+    }
+
+    // CIE94 distance of every color to `reference` (reference chroma weights, graphic arts)
+    inline void delta_e_94(const LAB &reference, std::span<const LAB> colors, std::span<double> out) {
+        delta_e_detail::one_to_many(colors, out, [&](const LAB &c) { return reference.delta_e_94(c); });
+    }
+
+    // CIEDE2000 distance of every color to `reference`
+    inline void delta_e_2000(const LAB &reference, std::span<const LAB> colors, std::span<double> out) {
+        delta_e_detail::one_to_many(colors, out, [&](const LAB &c) { return reference.delta_e_2000(c); });
+    }
+
+    // Element-wise CIEDE2000 of two equally sized spans
+    inline void delta_e_2000(std::span<const LAB> first, std::span<const LAB> second, std::span<double> out) {
+        if (second.size() != first.size()) {
+            throw std::invalid_argument("Color spans differ in size");
+        }
+        if (out.size() < first.size()) {
+            throw std::invalid_argument("Destination span is smaller than source span");
+        }
+        for (size_t i = 0; i < first.size(); ++i) {
+            out[i] = first[i].delta_e_2000(second[i]);
+        }
+    }
+
+    // QC pass: mask[i] = 1 when CIEDE2000(reference, colors[i]) < threshold (early-exit test); returns the count
+    inline size_t within_2000(const LAB &reference, std::span<const LAB> colors, double threshold,
+                              std::span<uint8_t> mask) {
+        if (mask.size() < colors.size()) {
+            throw std::invalid_argument("Destination span is smaller than source span");
+        }
+        size_t count = 0;
+        for (size_t i = 0; i < colors.size(); ++i) {
+            bool within = reference.is_within_2000(colors[i], threshold);
+            mask[i] = within;
+            count += within;
+        }
+        return count;
+    }
+
+    // Element-wise QC pass over pairs; returns the number of pairs within `threshold`
+    inline size_t within_2000(std::span<const LAB> first, std::span<const LAB> second, double threshold,
+                              std::span<uint8_t> mask) {
+        if (second.size() != first.size()) {
+            throw std::invalid_argument("Color spans differ in size");
+        }
+        if (mask.size() < first.size()) {
+            throw std::invalid_argument("Destination span is smaller than source span");
+        }
+        size_t count = 0;
+        for (size_t i = 0; i < first.size(); ++i) {
+            bool within = first[i].is_within_2000(second[i], threshold);
+            mask[i] = within;
+            count += within;
+        }
+        return count;
+    }
+
+} // namespace pigment
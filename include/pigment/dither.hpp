@@ -0,0 +1,253 @@
+#pragma once
+
+#include "palette_index.hpp"
+#include "parallel.hpp"
+#include "types_basic.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace pigment {
+    namespace dither {
+
+        enum class Method {
+            NONE,            // plain nearest color, same as PaletteIndex::quantize
+            FLOYD_STEINBERG, // error diffusion, 7/16 3/16 5/16 1/16
+            ATKINSON,        // error diffusion of 6/8 of the error; keeps more contrast, clips highlights
+            BAYER,           // 8x8 ordered threshold matrix
+            NOISE            // interleaved gradient noise thresholds (blue-noise-like, no visible tiling)
+        };
+
+        struct Options {
+            bool serpentine = true; // error diffusion alternates direction per row
+            float strength = 1.0f;  // ordered dithering amplitude, 1 = one palette step per channel
+        };
+
+        namespace detail {
+
+            // Row-major image geometry; height follows from the buffer size
+            inline size_t image_height(size_t pixels, size_t width) {
+                if (width == 0 || pixels % width != 0) {
+                    throw std::invalid_argument("Image buffer size is not a multiple of the width");
+                }
+                return pixels / width;
+            }
+
+            inline void check_output(std::span<const RGB> src, std::span<RGB> out, const PaletteIndex &index) {
+                if (out.size() < src.size()) {
+                    throw std::invalid_argument("Destination span is smaller than source span");
+                }
+                if (index.empty() && !src.empty()) {
+                    throw std::invalid_argument("Cannot query an empty palette");
+                }
+            }
+
+            // (dx, dy, weight) taps of an error diffusion kernel, for left-to-right rows
+            struct Tap {
+                int dx;
+                int dy;
+                float weight;
+            };
+            constexpr Tap FLOYD_STEINBERG[] = {
+                {1, 0, 7.0f / 16}, {-1, 1, 3.0f / 16}, {0, 1, 5.0f / 16}, {1, 1, 1.0f / 16}};
+            constexpr Tap ATKINSON[] = {{1, 0, 1.0f / 8}, {2, 0, 1.0f / 8}, {-1, 1, 1.0f / 8},
+                                        {0, 1, 1.0f / 8}, {1, 1, 1.0f / 8}, {0, 2, 1.0f / 8}};
+
+            // Direct-mapped memo of palette lookups. Dithered inputs repeat a lot (flat areas, the same threshold
+            // pattern over the same color), and one lookup costs a LAB conversion plus a k-d tree descent.
+            class NearestCache {
+                static constexpr size_t SIZE = 4096;
+                static constexpr uint32_t EMPTY = ~0u;
+
+                const PaletteIndex &index_;
+                std::vector<uint32_t> keys_ = std::vector<uint32_t>(SIZE, EMPTY);
+                std::vector<uint32_t> answers_ = std::vector<uint32_t>(SIZE);
+
+              public:
+                explicit NearestCache(const PaletteIndex &index) : index_(index) {}
+
+                const RGB &operator()(uint8_t r, uint8_t g, uint8_t b) {
+                    const uint32_t key = (uint32_t(r) << 16) | (uint32_t(g) << 8) | b;
+                    const size_t slot = ((key * 0x9E3779B1u) >> 20) & (SIZE - 1);
+                    if (keys_[slot] != key) {
+                        keys_[slot] = key;
+                        answers_[slot] = static_cast<uint32_t>(index_.nearest(RGB(r, g, b)));
+                    }
+                    return index_.colors()[answers_[slot]];
+                }
+            };
+
+            inline uint8_t to_channel(float v) { return static_cast<uint8_t>(std::clamp(v, 0.0f, 255.0f) + 0.5f); }
+
+            // Streams the image row by row. Only depth + 1 rows of error are alive at any time (two for
+            // Floyd-Steinberg, three for Atkinson), padded by 2 pixels on each side so taps need no bounds checks.
+            template <size_t N>
+            void diffuse(std::span<const RGB> src, size_t width, const PaletteIndex &index, std::span<RGB> out,
+                         const Tap (&taps)[N], bool serpentine) {
+                const size_t height = image_height(src.size(), width);
+                check_output(src, out, index);
+
+                int depth = 0;
+                for (const Tap &tap : taps) {
+                    depth = std::max(depth, tap.dy);
+                }
+                constexpr size_t PAD = 2;
+                const size_t stride = (width + 2 * PAD) * 3;
+                std::vector<float> error(stride * (depth + 1), 0.0f);
+                auto row_error = [&](size_t y) { return error.data() + (y % (depth + 1)) * stride; };
+                NearestCache nearest(index);
+
+                for (size_t y = 0; y < height; ++y) {
+                    const bool reverse = serpentine && (y % 2 == 1);
+                    float *current = row_error(y);
+                    for (size_t step = 0; step < width; ++step) {
+                        const size_t x = reverse ? width - 1 - step : step;
+                        const RGB &in = src[y * width + x];
+                        float *e = current + (x + PAD) * 3;
+                        const float wanted[3] = {in.r() + e[0], in.g() + e[1], in.b() + e[2]};
+                        const RGB &chosen =
+                            nearest(to_channel(wanted[0]), to_channel(wanted[1]), to_channel(wanted[2]));
+                        out[y * width + x] = chosen;
+
+                        const float diff[3] = {wanted[0] - chosen.r(), wanted[1] - chosen.g(), wanted[2] - chosen.b()};
+                        for (const Tap &tap : taps) {
+                            const ptrdiff_t dx = reverse ? -tap.dx : tap.dx;
+                            float *target = row_error(y + tap.dy) + (static_cast<ptrdiff_t>(x + PAD) + dx) * 3;
+                            for (int c = 0; c < 3; ++c) {
+                                target[c] += diff[c] * tap.weight;
+                            }
+                        }
+                    }
+                    // This row's buffer is reused for row y + depth + 1
+                    std::fill(current, current + stride, 0.0f);
+                }
+            }
+
+            // Bayer threshold matrix, values 0-63
+            constexpr std::array<uint8_t, 64> make_bayer8() {
+                std::array<uint8_t, 64> m{};
+                for (int y = 0; y < 8; ++y) {
+                    for (int x = 0; x < 8; ++x) {
+                        int v = 0;
+                        for (int bit = 0; bit < 3; ++bit) {
+                            const int xb = (x >> bit) & 1, yb = (y >> bit) & 1;
+                            v |= ((xb ^ yb) << (5 - 2 * bit)) | (yb << (4 - 2 * bit));
+                        }
+                        m[y * 8 + x] = static_cast<uint8_t>(v);
+                    }
+                }
+                return m;
+            }
+            constexpr std::array<uint8_t, 64> BAYER8 = make_bayer8();
+
+            // Threshold in [-0.5, 0.5) for pixel (x, y)
+            inline float bayer_threshold(size_t x, size_t y) {
+                return (BAYER8[(y & 7) * 8 + (x & 7)] + 0.5f) / 64.0f - 0.5f;
+            }
+
+            // Interleaved gradient noise (Jimenez 2014)
+            inline float noise_threshold(size_t x, size_t y) {
+                const float t = 0.06711056f * static_cast<float>(x) + 0.00583715f * static_cast<float>(y);
+                const float v = 52.9829189f * (t - std::floor(t));
+                return (v - std::floor(v)) - 0.5f;
+            }
+
+            // Spacing between palette levels per channel if the palette were a uniform grid
+            inline float palette_step(const PaletteIndex &index) {
+                return 255.0f / std::max(1.0f, std::cbrt(static_cast<float>(index.size())) - 1.0f);
+            }
+
+            template <typename Threshold, typename Executor>
+            void ordered(std::span<const RGB> src, size_t width, const PaletteIndex &index, std::span<RGB> out,
+                         float strength, Threshold threshold, Executor &executor, size_t tile_size) {
+                image_height(src.size(), width);
+                check_output(src, out, index);
+                const float amplitude = palette_step(index) * strength;
+                parallel::for_each_tile(
+                    src.size(), executor,
+                    [&](size_t begin, size_t end) {
+                        NearestCache nearest(index);
+                        for (size_t i = begin; i < end; ++i) {
+                            const float offset = threshold(i % width, i / width) * amplitude;
+                            const RGB &in = src[i];
+                            out[i] = nearest(to_channel(in.r() + offset), to_channel(in.g() + offset),
+                                             to_channel(in.b() + offset));
+                        }
+                    },
+                    tile_size);
+            }
+
+        } // namespace detail
+
+        // Floyd-Steinberg error diffusion over a row-major `width`-wide image
+        inline void floyd_steinberg(std::span<const RGB> src, size_t width, const PaletteIndex &index,
+                                    std::span<RGB> out, bool serpentine = true) {
+            detail::diffuse(src, width, index, out, detail::FLOYD_STEINBERG, serpentine);
+        }
+
+        // Atkinson error diffusion over a row-major `width`-wide image
+        inline void atkinson(std::span<const RGB> src, size_t width, const PaletteIndex &index, std::span<RGB> out,
+                             bool serpentine = true) {
+            detail::diffuse(src, width, index, out, detail::ATKINSON, serpentine);
+        }
+
+        // Ordered dithering with the 8x8 Bayer matrix; every pixel is independent, so tiles run on `executor`
+        template <typename Executor = parallel::ThreadExecutor>
+        void bayer(std::span<const RGB> src, size_t width, const PaletteIndex &index, std::span<RGB> out,
+                   float strength = 1.0f, Executor &&executor = Executor{},
+                   size_t tile_size = parallel::DEFAULT_TILE_SIZE) {
+            detail::ordered(src, width, index, out, strength, detail::bayer_threshold, executor, tile_size);
+        }
+
+        // Ordered dithering with interleaved gradient noise thresholds
+        template <typename Executor = parallel::ThreadExecutor>
+        void noise(std::span<const RGB> src, size_t width, const PaletteIndex &index, std::span<RGB> out,
+                   float strength = 1.0f, Executor &&executor = Executor{},
+                   size_t tile_size = parallel::DEFAULT_TILE_SIZE) {
+            detail::ordered(src, width, index, out, strength, detail::noise_threshold, executor, tile_size);
+        }
+
+        // Quantize a row-major image to the palette with the chosen method. Error diffusion is inherently
+        // sequential and ignores `executor`; the other methods run tiled on it.
+        template <typename Executor = parallel::ThreadExecutor>
+        void quantize(std::span<const RGB> src, size_t width, const PaletteIndex &index, std::span<RGB> out,
+                      Method method, const Options &options = {}, Executor &&executor = Executor{}) {
+            PIGMENT_SCOPE_N("dither::quantize", src.size());
+            switch (method) {
+            case Method::NONE:
+                detail::image_height(src.size(), width);
+                detail::check_output(src, out, index);
+                parallel::for_each_tile(src.size(), executor, [&](size_t begin, size_t end) {
+                    index.quantize(src.subspan(begin, end - begin), out.subspan(begin, end - begin));
+                });
+                return;
+            case Method::FLOYD_STEINBERG:
+                floyd_steinberg(src, width, index, out, options.serpentine);
+                return;
+            case Method::ATKINSON:
+                atkinson(src, width, index, out, options.serpentine);
+                return;
+            case Method::BAYER:
+                bayer(src, width, index, out, options.strength, executor);
+                return;
+            case Method::NOISE:
+                noise(src, width, index, out, options.strength, executor);
+                return;
+            }
+        }
+
+        template <typename Executor = parallel::ThreadExecutor>
+        std::vector<RGB> quantize(std::span<const RGB> src, size_t width, const std::vector<RGB> &palette,
+                                  Method method, const Options &options = {}, Executor &&executor = Executor{}) {
+            std::vector<RGB> out(src.size());
+            quantize(src, width, PaletteIndex(palette), out, method, options, executor);
+            return out;
+        }
+
+    } // namespace dither
+} // namespace pigment
@@ -0,0 +1,281 @@
+#pragma once
+
+#include "convert.hpp"
+#include "histogram.hpp"
+#include "parallel.hpp"
+#include "types_basic.hpp"
+#include "types_float.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <span>
+#include <vector>
+
+namespace pigment {
+    namespace dominant {
+
+        struct MedianCutOptions {
+            size_t max_samples = 0; // colors kept (evenly strided) before binning, 0 = all
+        };
+
+        struct KMeansOptions {
+            size_t max_samples = 200000; // colors kept (evenly strided) before clustering, 0 = all
+            size_t batch_size = 1024;    // samples per mini-batch step
+            size_t iterations = 100;     // mini-batch steps
+            uint32_t seed = 0x5EED;      // k-means++ seeding and batch selection
+        };
+
+        namespace detail {
+
+            inline size_t sample_stride(size_t n, size_t max_samples) {
+                return (max_samples == 0 || n <= max_samples) ? 1 : (n + max_samples - 1) / max_samples;
+            }
+
+            struct Box {
+                size_t begin;
+                size_t end; // range into the non-empty bin list
+                uint64_t population;
+                int axis;
+                int span; // extent along `axis` in bin units
+            };
+
+        } // namespace detail
+
+        // Median cut over a color histogram: the box with the largest population-weighted extent is split along
+        // its widest channel until `count` boxes exist. Returns box averages (exact, from the per-bin sums), most
+        // populous first.
+        inline std::vector<RGB> median_cut(const Histogram &hist, size_t count) {
+            using namespace detail;
+            if (hist.empty() || count == 0) {
+                return {};
+            }
+
+            const unsigned bits = hist.bits();
+            const int top = (1 << bits) - 1;
+            std::vector<Histogram::Bin> bins = hist.bins();
+            auto channel = [bits, top](const Histogram::Bin &bin, int axis) {
+                return int(bin.index >> (bits * (2 - axis))) & top;
+            };
+            auto make_box = [&](size_t begin, size_t end) {
+                int lo[3] = {top, top, top}, hi[3] = {0, 0, 0};
+                uint64_t population = 0;
+                for (size_t i = begin; i < end; ++i) {
+                    population += bins[i].count;
+                    for (int c = 0; c < 3; ++c) {
+                        lo[c] = std::min(lo[c], channel(bins[i], c));
+                        hi[c] = std::max(hi[c], channel(bins[i], c));
+                    }
+                }
+                int axis = 0;
+                for (int c = 1; c < 3; ++c) {
+                    if (hi[c] - lo[c] > hi[axis] - lo[axis]) {
+                        axis = c;
+                    }
+                }
+                return Box{begin, end, population, axis, hi[axis] - lo[axis]};
+            };
+
+            // Cell spread of a box along its widest channel, weighted by population
+            auto score = [](const Box &box) { return double(box.population) * box.span * box.span; };
+
+            std::vector<Box> boxes = {make_box(0, bins.size())};
+            while (boxes.size() < count) {
+                // Split the box with the largest weighted spread that still has 2+ distinct positions on its axis
+                auto target = boxes.end();
+                for (auto it = boxes.begin(); it != boxes.end(); ++it) {
+                    if (it->span > 0 && (target == boxes.end() || score(*it) > score(*target))) {
+                        target = it;
+                    }
+                }
+                if (target == boxes.end()) {
+                    break;
+                }
+
+                // Cut between two channel positions where the between-class variance is largest; unlike the
+                // plain population median this never cuts through the middle of a single dense cluster
+                Box box = *target;
+                std::sort(bins.begin() + box.begin, bins.begin() + box.end,
+                          [&](const Histogram::Bin &a, const Histogram::Bin &b) {
+                              return channel(a, box.axis) < channel(b, box.axis);
+                          });
+                double total_weight = double(box.population), total_sum = 0.0;
+                for (size_t i = box.begin; i < box.end; ++i) {
+                    total_sum += double(bins[i].count) * channel(bins[i], box.axis);
+                }
+                double weight = 0.0, sum = 0.0, best = -1.0;
+                size_t split = box.begin + 1;
+                for (size_t i = box.begin; i + 1 < box.end; ++i) {
+                    weight += double(bins[i].count);
+                    sum += double(bins[i].count) * channel(bins[i], box.axis);
+                    if (channel(bins[i], box.axis) == channel(bins[i + 1], box.axis)) {
+                        continue;
+                    }
+                    double rest = total_weight - weight;
+                    double diff = sum / weight - (total_sum - sum) / rest;
+                    double between = weight * rest * diff * diff;
+                    if (between > best) {
+                        best = between;
+                        split = i + 1;
+                    }
+                }
+                *target = make_box(box.begin, split);
+                boxes.push_back(make_box(split, box.end));
+            }
+
+            std::sort(boxes.begin(), boxes.end(),
+                      [](const Box &a, const Box &b) { return a.population > b.population; });
+            std::vector<RGB> result;
+            result.reserve(boxes.size());
+            for (const Box &box : boxes) {
+                uint64_t sum[3] = {0, 0, 0};
+                for (size_t i = box.begin; i < box.end; ++i) {
+                    for (int c = 0; c < 3; ++c) {
+                        sum[c] += bins[i].sum[c];
+                    }
+                }
+                auto average = [&](int c) {
+                    return static_cast<uint8_t>((sum[c] + box.population / 2) / box.population);
+                };
+                result.emplace_back(average(0), average(1), average(2));
+            }
+            return result;
+        }
+
+        // Same over a 5-bit histogram of `colors`, built on `executor`
+        template <typename Executor = parallel::ThreadExecutor>
+        std::vector<RGB> median_cut(std::span<const RGB> colors, size_t count, const MedianCutOptions &options = {},
+                                    Executor &&executor = Executor{}) {
+            PIGMENT_SCOPE_N("median_cut", colors.size());
+            if (colors.empty() || count == 0) {
+                return {};
+            }
+            const Histogram hist = Histogram::build(colors, Histogram::DEFAULT_BITS, executor,
+                                                    detail::sample_stride(colors.size(), options.max_samples));
+            return median_cut(hist, count);
+        }
+
+        // Mini-batch k-means (Sculley 2010) in OKLAB with k-means++ seeding. The final assignment over the whole
+        // sample runs on `executor`; results are deterministic for a given seed and do not depend on the
+        // executor. Returns cluster centers, most populous first.
+        template <typename Executor = parallel::ThreadExecutor>
+        std::vector<RGB> kmeans(std::span<const RGB> colors, size_t count, const KMeansOptions &options = {},
+                                Executor &&executor = Executor{}) {
+            PIGMENT_SCOPE_N("kmeans", colors.size());
+            if (colors.empty() || count == 0) {
+                return {};
+            }
+
+            // Strided sample converted to OKLAB once through the float batch kernels
+            const size_t stride = detail::sample_stride(colors.size(), options.max_samples);
+            std::vector<RGB> sampled;
+            sampled.reserve((colors.size() + stride - 1) / stride);
+            for (size_t i = 0; i < colors.size(); i += stride) {
+                sampled.push_back(colors[i]);
+            }
+            std::vector<OKLABf> points(sampled.size());
+            convert(std::span<const RGB>(sampled), std::span<OKLABf>(points));
+            count = std::min(count, points.size());
+
+            auto distance_sq = [](const OKLABf &p, const OKLABf &q) {
+                float dl = p.l() - q.l(), da = p.a() - q.a(), db = p.b() - q.b();
+                return dl * dl + da * da + db * db;
+            };
+            std::vector<OKLABf> centers;
+            auto nearest = [&](const OKLABf &p) {
+                size_t best = 0;
+                float best_dist = std::numeric_limits<float>::max();
+                for (size_t c = 0; c < centers.size(); ++c) {
+                    float d = distance_sq(p, centers[c]);
+                    if (d < best_dist) {
+                        best_dist = d;
+                        best = c;
+                    }
+                }
+                return best;
+            };
+
+            // k-means++ seeding: each new center is drawn with probability proportional to D^2
+            std::mt19937 rng(options.seed);
+            centers.push_back(points[std::uniform_int_distribution<size_t>(0, points.size() - 1)(rng)]);
+            std::vector<float> min_dist(points.size());
+            for (size_t i = 0; i < points.size(); ++i) {
+                min_dist[i] = distance_sq(points[i], centers[0]);
+            }
+            while (centers.size() < count) {
+                double total = 0.0;
+                for (float d : min_dist) {
+                    total += d;
+                }
+                size_t pick = 0;
+                if (total > 0.0) {
+                    double target = std::uniform_real_distribution<double>(0.0, total)(rng);
+                    for (; pick + 1 < points.size() && (target -= min_dist[pick]) > 0.0; ++pick) {
+                    }
+                } else {
+                    break; // fewer distinct colors than requested clusters
+                }
+                centers.push_back(points[pick]);
+                // One distance per point: cheaper than handing a pass per center to the executor
+                for (size_t i = 0; i < points.size(); ++i) {
+                    min_dist[i] = std::min(min_dist[i], distance_sq(points[i], centers.back()));
+                }
+            }
+
+            // Mini-batch refinement with per-center learning rate 1 / (assignments so far). A batch is a few
+            // microseconds of work, so it runs on the calling thread; only the full-sample pass below uses
+            // `executor`.
+            const size_t batch_size = std::min(std::max<size_t>(options.batch_size, 1), points.size());
+            std::vector<size_t> batch(batch_size);
+            std::vector<uint32_t> assignment(batch_size);
+            std::vector<uint64_t> seen(centers.size(), 0);
+            std::uniform_int_distribution<size_t> pick_sample(0, points.size() - 1);
+            for (size_t iter = 0; iter < options.iterations; ++iter) {
+                for (auto &index : batch) {
+                    index = pick_sample(rng);
+                }
+                for (size_t i = 0; i < batch_size; ++i) {
+                    assignment[i] = static_cast<uint32_t>(nearest(points[batch[i]]));
+                }
+                for (size_t i = 0; i < batch_size; ++i) {
+                    OKLABf &center = centers[assignment[i]];
+                    const OKLABf &p = points[batch[i]];
+                    float eta = 1.0f / static_cast<float>(++seen[assignment[i]]);
+                    center.l() += eta * (p.l() - center.l());
+                    center.a() += eta * (p.a() - center.a());
+                    center.b() += eta * (p.b() - center.b());
+                }
+            }
+
+            // Final populations over the whole sample to order the result
+            std::vector<uint32_t> labels(points.size());
+            parallel::for_each_tile(points.size(), executor, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    labels[i] = static_cast<uint32_t>(nearest(points[i]));
+                }
+            });
+            std::vector<uint64_t> population(centers.size(), 0);
+            for (uint32_t label : labels) {
+                ++population[label];
+            }
+            std::vector<size_t> order(centers.size());
+            for (size_t i = 0; i < order.size(); ++i) {
+                order[i] = i;
+            }
+            std::stable_sort(order.begin(), order.end(),
+                             [&](size_t a, size_t b) { return population[a] > population[b]; });
+
+            std::vector<RGB> result;
+            result.reserve(order.size());
+            for (size_t c : order) {
+                if (population[c] > 0) {
+                    result.push_back(centers[c].to_rgb());
+                }
+            }
+            return result;
+        }
+
+    } // namespace dominant
+} // namespace pigment
@@ -0,0 +1,333 @@
+#pragma once
+
+#include "parallel.hpp"
+#include "types_basic.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace pigment {
+
+    /**
+     * @brief 3D color histogram with exact per-bin channel sums
+     *
+     * Each channel is truncated to `bits` bits (1-8) and the bin index is r << 2 * bits | g << bits | b. Every bin
+     * also keeps the sum of the colors that fell into it, so bin means are the real average color rather than the
+     * bin center. Up to DENSE_MAX_BITS the bins are a flat array; above that only occupied bins are stored, which
+     * makes bits = 8 an exact, sparse count of distinct 24-bit colors. Alpha is ignored.
+     */
+    class Histogram {
+      public:
+        static constexpr unsigned DEFAULT_BITS = 5;
+        static constexpr unsigned EXACT_BITS = 8;
+        static constexpr unsigned DENSE_MAX_BITS = 6; // 262144 bins, 8 MB
+
+        struct Bin {
+            uint32_t index = 0;
+            uint64_t count = 0;
+            std::array<uint64_t, 3> sum{}; // r, g, b
+
+            // Average color of the bin (rounded)
+            RGB mean() const {
+                auto average = [this](int c) { return static_cast<uint8_t>((sum[c] + count / 2) / count); };
+                return count ? RGB(average(0), average(1), average(2)) : RGB();
+            }
+        };
+
+        // Statistics of every added color (not of the bins), so they do not depend on `bits`
+        struct Moments {
+            uint64_t count = 0;
+            std::array<double, 3> mean{};     // r, g, b in 0-255
+            std::array<double, 3> variance{}; // population variance per channel
+        };
+
+      private:
+        struct Cell {
+            uint64_t count = 0;
+            std::array<uint64_t, 3> sum{};
+        };
+
+        // Occupied bins only: open addressing with linear probing, kept at most half full
+        class SparseCells {
+            static constexpr uint32_t EMPTY = ~0u; // bin indices stay below 2^24
+
+            std::vector<uint32_t> keys_;
+            std::vector<Cell> cells_;
+            size_t used_ = 0;
+
+            static size_t hash(uint32_t index) {
+                index ^= index >> 16;
+                index *= 0x85EBCA6Bu;
+                index ^= index >> 13;
+                return index;
+            }
+
+            void grow() {
+                std::vector<uint32_t> keys(std::max<size_t>(keys_.size() * 2, 1024), EMPTY);
+                std::vector<Cell> cells(keys.size());
+                const size_t mask = keys.size() - 1;
+                for (size_t i = 0; i < keys_.size(); ++i) {
+                    if (keys_[i] != EMPTY) {
+                        size_t slot = hash(keys_[i]) & mask;
+                        while (keys[slot] != EMPTY) {
+                            slot = (slot + 1) & mask;
+                        }
+                        keys[slot] = keys_[i];
+                        cells[slot] = cells_[i];
+                    }
+                }
+                keys_.swap(keys);
+                cells_.swap(cells);
+            }
+
+          public:
+            size_t size() const { return used_; }
+
+            Cell &operator[](uint32_t index) {
+                if ((used_ + 1) * 2 > keys_.size()) {
+                    grow();
+                }
+                const size_t mask = keys_.size() - 1;
+                for (size_t slot = hash(index) & mask;; slot = (slot + 1) & mask) {
+                    if (keys_[slot] == index) {
+                        return cells_[slot];
+                    }
+                    if (keys_[slot] == EMPTY) {
+                        keys_[slot] = index;
+                        ++used_;
+                        return cells_[slot];
+                    }
+                }
+            }
+
+            const Cell *find(uint32_t index) const {
+                if (keys_.empty()) {
+                    return nullptr;
+                }
+                const size_t mask = keys_.size() - 1;
+                for (size_t slot = hash(index) & mask;; slot = (slot + 1) & mask) {
+                    if (keys_[slot] == index) {
+                        return &cells_[slot];
+                    }
+                    if (keys_[slot] == EMPTY) {
+                        return nullptr;
+                    }
+                }
+            }
+
+            template <typename Fn> void for_each(Fn &&fn) const {
+                for (size_t i = 0; i < keys_.size(); ++i) {
+                    if (keys_[i] != EMPTY) {
+                        fn(keys_[i], cells_[i]);
+                    }
+                }
+            }
+        };
+
+        unsigned bits_ = DEFAULT_BITS;
+        std::vector<Cell> dense_;
+        SparseCells sparse_;
+        uint64_t total_ = 0;
+        std::array<uint64_t, 3> sum_{};
+        std::array<uint64_t, 3> sum_sq_{};
+
+        Cell &cell(uint32_t index) { return sparse() ? sparse_[index] : dense_[index]; }
+
+        static void accumulate(Cell &c, const RGB &color, uint64_t weight) {
+            c.count += weight;
+            c.sum[0] += weight * color.r();
+            c.sum[1] += weight * color.g();
+            c.sum[2] += weight * color.b();
+        }
+
+        static void accumulate(Cell &c, const Cell &other) {
+            c.count += other.count;
+            for (int k = 0; k < 3; ++k) {
+                c.sum[k] += other.sum[k];
+            }
+        }
+
+        static Bin make_bin(uint32_t index, const Cell &c) { return Bin{index, c.count, c.sum}; }
+
+      public:
+        explicit Histogram(unsigned bits = DEFAULT_BITS) : bits_(bits) {
+            if (bits < 1 || bits > EXACT_BITS) {
+                throw std::invalid_argument("Histogram bits per channel must be in [1, 8]");
+            }
+            if (!sparse()) {
+                dense_.resize(size_t(1) << (3 * bits));
+            }
+        }
+
+        // Histogram of every `stride`-th color, accumulated in up to 8 partial histograms on `executor` and merged.
+        // A serial executor or a single chunk fills the result directly (no partials, no merge).
+        template <typename Executor>
+        static Histogram build(std::span<const RGB> colors, unsigned bits, Executor &&executor, size_t stride = 1) {
+            PIGMENT_SCOPE_N("Histogram::build", colors.size());
+            stride = std::max<size_t>(stride, 1);
+            const size_t samples = (colors.size() + stride - 1) / stride;
+            const size_t chunks = std::clamp<size_t>(samples / parallel::DEFAULT_TILE_SIZE, 1, 8);
+            if (std::is_same_v<std::remove_cvref_t<Executor>, parallel::SerialExecutor> || chunks == 1) {
+                Histogram result(bits);
+                result.add(colors, stride);
+                return result;
+            }
+            std::vector<Histogram> partial(chunks, Histogram(bits));
+            executor(chunks, [&](size_t chunk) {
+                const size_t begin = samples * chunk / chunks;
+                const size_t end = samples * (chunk + 1) / chunks;
+                for (size_t i = begin; i < end; ++i) {
+                    partial[chunk].add(colors[i * stride]);
+                }
+            });
+            for (size_t i = 1; i < chunks; ++i) {
+                partial[0].merge(partial[i]);
+            }
+            return std::move(partial[0]);
+        }
+
+        static Histogram build(std::span<const RGB> colors, unsigned bits = DEFAULT_BITS, size_t stride = 1) {
+            return build(colors, bits, parallel::SerialExecutor{}, stride);
+        }
+
+        unsigned bits() const { return bits_; }
+        bool sparse() const { return bits_ > DENSE_MAX_BITS; }
+
+        // Number of bins in the grid, occupied or not
+        size_t bin_count() const { return size_t(1) << (3 * bits_); }
+
+        // Number of colors added (sum of all bin counts)
+        uint64_t total() const { return total_; }
+        bool empty() const { return total_ == 0; }
+
+        uint32_t bin(const RGB &color) const {
+            const unsigned shift = 8 - bits_;
+            return (uint32_t(color.r() >> shift) << (2 * bits_)) | (uint32_t(color.g() >> shift) << bits_) |
+                   uint32_t(color.b() >> shift);
+        }
+
+        // Lowest color that falls into `index`
+        RGB bin_origin(uint32_t index) const {
+            const unsigned shift = 8 - bits_;
+            const uint32_t mask = (1u << bits_) - 1;
+            return RGB(static_cast<uint8_t>(((index >> (2 * bits_)) & mask) << shift),
+                       static_cast<uint8_t>(((index >> bits_) & mask) << shift),
+                       static_cast<uint8_t>((index & mask) << shift));
+        }
+
+        void add(const RGB &color, uint64_t weight = 1) {
+            accumulate(cell(bin(color)), color, weight);
+            total_ += weight;
+            const uint64_t channels[3] = {color.r(), color.g(), color.b()};
+            for (int k = 0; k < 3; ++k) {
+                sum_[k] += weight * channels[k];
+                sum_sq_[k] += weight * channels[k] * channels[k];
+            }
+        }
+
+        void add(std::span<const RGB> colors, size_t stride = 1) {
+            stride = std::max<size_t>(stride, 1);
+            for (size_t i = 0; i < colors.size(); i += stride) {
+                add(colors[i]);
+            }
+        }
+
+        // Fold another histogram with the same `bits` into this one
+        void merge(const Histogram &other) {
+            if (other.bits_ != bits_) {
+                throw std::invalid_argument("Cannot merge histograms with different bits per channel");
+            }
+            if (sparse()) {
+                other.sparse_.for_each([this](uint32_t index, const Cell &c) { accumulate(sparse_[index], c); });
+            } else {
+                for (size_t i = 0; i < dense_.size(); ++i) {
+                    accumulate(dense_[i], other.dense_[i]);
+                }
+            }
+            total_ += other.total_;
+            for (int k = 0; k < 3; ++k) {
+                sum_[k] += other.sum_[k];
+                sum_sq_[k] += other.sum_sq_[k];
+            }
+        }
+
+        void clear() { *this = Histogram(bits_); }
+
+        uint64_t count(uint32_t index) const {
+            if (sparse()) {
+                const Cell *c = sparse_.find(index);
+                return c ? c->count : 0;
+            }
+            return index < dense_.size() ? dense_[index].count : 0;
+        }
+
+        uint64_t count(const RGB &color) const { return count(bin(color)); }
+
+        // Number of non-empty bins
+        size_t occupied() const {
+            if (sparse()) {
+                return sparse_.size();
+            }
+            return static_cast<size_t>(
+                std::count_if(dense_.begin(), dense_.end(), [](const Cell &c) { return c.count != 0; }));
+        }
+
+        // Non-empty bins in index order
+        std::vector<Bin> bins() const {
+            std::vector<Bin> result;
+            if (sparse()) {
+                result.reserve(sparse_.size());
+                sparse_.for_each([&result](uint32_t index, const Cell &c) { result.push_back(make_bin(index, c)); });
+                std::sort(result.begin(), result.end(), [](const Bin &a, const Bin &b) { return a.index < b.index; });
+            } else {
+                for (uint32_t i = 0; i < dense_.size(); ++i) {
+                    if (dense_[i].count) {
+                        result.push_back(make_bin(i, dense_[i]));
+                    }
+                }
+            }
+            return result;
+        }
+
+        // The `k` most populous bins, largest first (lower index first on ties)
+        std::vector<Bin> top(size_t k) const {
+            std::vector<Bin> result = bins();
+            k = std::min(k, result.size());
+            std::partial_sort(result.begin(), result.begin() + k, result.end(), [](const Bin &a, const Bin &b) {
+                return a.count != b.count ? a.count > b.count : a.index < b.index;
+            });
+            result.resize(k);
+            return result;
+        }
+
+        Moments moments() const {
+            Moments m;
+            m.count = total_;
+            if (total_ == 0) {
+                return m;
+            }
+            const double n = static_cast<double>(total_);
+            for (int k = 0; k < 3; ++k) {
+                m.mean[k] = static_cast<double>(sum_[k]) / n;
+                m.variance[k] = std::max(0.0, static_cast<double>(sum_sq_[k]) / n - m.mean[k] * m.mean[k]);
+            }
+            return m;
+        }
+
+        // Average of every added color
+        RGB mean() const {
+            if (total_ == 0) {
+                return RGB();
+            }
+            auto average = [this](int c) { return static_cast<uint8_t>((sum_[c] + total_ / 2) / total_); };
+            return RGB(average(0), average(1), average(2));
+        }
+    };
+
+} // namespace pigment
@@ -0,0 +1,308 @@
+#pragma once
+
+// Opt-in counters and timers for pigment's hot paths. Build with -DPIGMENT_ENABLE_INSTRUMENTATION (CMake option
+// PIGMENT_ENABLE_INSTRUMENTATION) to record:
+//   - how many conversions of each kind ran, counted where they happen (scalar fromRGB / to_rgb and the batch
+//     kernels), so a sort or palette lookup shows up as the LAB / OKLAB / HSL work it triggered
+//   - per entry point (sort_by_hue, find_closest_color, convert, ...): calls, items processed, wall time
+// Without the define every PIGMENT_COUNT / PIGMENT_SCOPE macro expands to nothing and snapshot() returns empty
+// stats, so the API can stay in place in production code at no cost.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifdef PIGMENT_ENABLE_INSTRUMENTATION
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#endif
+
+namespace pigment {
+    namespace instrumentation {
+
+#ifdef PIGMENT_ENABLE_INSTRUMENTATION
+        inline constexpr bool ENABLED = true;
+#else
+        inline constexpr bool ENABLED = false;
+#endif
+
+        enum class Counter : size_t {
+            LAB_FROM_RGB,
+            LAB_TO_RGB,
+            LCH_FROM_RGB,
+            LCH_TO_RGB,
+            XYZ_FROM_RGB,
+            XYZ_TO_RGB,
+            OKLAB_FROM_RGB,
+            OKLAB_FROM_RGB_FAST,
+            OKLAB_TO_RGB,
+            HSL_FROM_RGB,
+            HSL_TO_RGB,
+            HSV_FROM_RGB,
+            HSV_TO_RGB,
+            COUNT
+        };
+
+        inline constexpr size_t COUNTER_COUNT = static_cast<size_t>(Counter::COUNT);
+
+        inline constexpr std::string_view counter_name(Counter counter) {
+            constexpr std::string_view NAMES[COUNTER_COUNT] = {
+                "LAB::fromRGB", "LAB::to_rgb",    "LCH::fromRGB",        "LCH::to_rgb",   "XYZ::fromRGB",
+                "XYZ::to_rgb",  "OKLAB::fromRGB", "OKLAB::fromRGB_fast", "OKLAB::to_rgb", "HSL::fromRGB",
+                "HSL::to_rgb",  "HSV::fromRGB",   "HSV::to_rgb"};
+            return counter < Counter::COUNT ? NAMES[static_cast<size_t>(counter)] : std::string_view("?");
+        }
+
+        // One instrumented entry point. Scopes sharing a name (e.g. every convert() overload) are merged.
+        struct ScopeStats {
+            std::string name;
+            uint64_t calls = 0;
+            uint64_t items = 0;     // sum of batch sizes, for scopes that report one
+            uint64_t max_items = 0; // largest single batch
+            uint64_t total_ns = 0;
+            uint64_t max_ns = 0;
+
+            double mean_ns() const { return calls ? static_cast<double>(total_ns) / static_cast<double>(calls) : 0.0; }
+        };
+
+        struct Stats {
+            std::array<uint64_t, COUNTER_COUNT> conversions{};
+            std::vector<ScopeStats> scopes; // sorted by total time, slowest first
+
+            uint64_t count(Counter counter) const { return conversions[static_cast<size_t>(counter)]; }
+
+            uint64_t total_conversions() const {
+                uint64_t sum = 0;
+                for (uint64_t c : conversions) {
+                    sum += c;
+                }
+                return sum;
+            }
+
+            const ScopeStats *scope(std::string_view name) const {
+                for (const ScopeStats &s : scopes) {
+                    if (s.name == name) {
+                        return &s;
+                    }
+                }
+                return nullptr;
+            }
+
+            // Plain-text table, one line per non-zero counter and per scope
+            std::string report() const {
+                std::string out;
+                for (size_t i = 0; i < COUNTER_COUNT; ++i) {
+                    if (conversions[i]) {
+                        out += std::string(counter_name(static_cast<Counter>(i)));
+                        out += ": " + std::to_string(conversions[i]) + "\n";
+                    }
+                }
+                for (const ScopeStats &s : scopes) {
+                    out += s.name + ": " + std::to_string(s.calls) + " calls, " + std::to_string(s.items) +
+                           " items (max " + std::to_string(s.max_items) + "), " +
+                           std::to_string(s.total_ns / 1000) + " us total, " + std::to_string(s.max_ns / 1000) +
+                           " us max\n";
+                }
+                return out;
+            }
+        };
+
+#ifdef PIGMENT_ENABLE_INSTRUMENTATION
+
+        namespace detail {
+
+            // Conversion counts of one thread. Only the owning thread writes (load + store, no locked add), other
+            // threads read them when taking a snapshot.
+            struct CounterBlock {
+                std::array<std::atomic<uint64_t>, COUNTER_COUNT> values{};
+            };
+
+            class Scope;
+
+            struct Registry {
+                std::mutex mutex;
+                std::vector<CounterBlock *> live;
+                std::array<uint64_t, COUNTER_COUNT> retired{};  // from threads that have exited
+                std::array<uint64_t, COUNTER_COUNT> baseline{}; // totals at the last reset()
+                std::vector<Scope *> scopes;
+
+                std::array<uint64_t, COUNTER_COUNT> totals() const {
+                    std::array<uint64_t, COUNTER_COUNT> sum = retired;
+                    for (const CounterBlock *block : live) {
+                        for (size_t i = 0; i < COUNTER_COUNT; ++i) {
+                            sum[i] += block->values[i].load(std::memory_order_relaxed);
+                        }
+                    }
+                    return sum;
+                }
+            };
+
+            inline Registry &registry() {
+                static Registry instance;
+                return instance;
+            }
+
+            class ThreadCounters {
+                CounterBlock block_;
+
+              public:
+                ThreadCounters() {
+                    Registry &r = registry();
+                    std::lock_guard<std::mutex> lock(r.mutex);
+                    r.live.push_back(&block_);
+                }
+
+                ~ThreadCounters() {
+                    Registry &r = registry();
+                    std::lock_guard<std::mutex> lock(r.mutex);
+                    for (size_t i = 0; i < COUNTER_COUNT; ++i) {
+                        r.retired[i] += block_.values[i].load(std::memory_order_relaxed);
+                    }
+                    r.live.erase(std::find(r.live.begin(), r.live.end(), &block_));
+                }
+
+                void add(Counter counter, uint64_t n) {
+                    auto &value = block_.values[static_cast<size_t>(counter)];
+                    value.store(value.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+                }
+            };
+
+            inline void count(Counter counter, uint64_t n = 1) {
+                thread_local ThreadCounters counters;
+                counters.add(counter, n);
+            }
+
+            inline void update_max(std::atomic<uint64_t> &max, uint64_t value) {
+                uint64_t current = max.load(std::memory_order_relaxed);
+                while (value > current && !max.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+                }
+            }
+
+            // Statistics of one PIGMENT_SCOPE site; a function-local static, registered on first use
+            class Scope {
+                const char *name_;
+
+              public:
+                std::atomic<uint64_t> calls{0}, items{0}, max_items{0}, total_ns{0}, max_ns{0};
+
+                explicit Scope(const char *name) : name_(name) {
+                    Registry &r = registry();
+                    std::lock_guard<std::mutex> lock(r.mutex);
+                    r.scopes.push_back(this);
+                }
+
+                const char *name() const { return name_; }
+
+                void record(uint64_t elapsed_ns, uint64_t batch) {
+                    calls.fetch_add(1, std::memory_order_relaxed);
+                    total_ns.fetch_add(elapsed_ns, std::memory_order_relaxed);
+                    update_max(max_ns, elapsed_ns);
+                    if (batch) {
+                        items.fetch_add(batch, std::memory_order_relaxed);
+                        update_max(max_items, batch);
+                    }
+                }
+
+                void reset() {
+                    for (auto *field : {&calls, &items, &max_items, &total_ns, &max_ns}) {
+                        field->store(0, std::memory_order_relaxed);
+                    }
+                }
+            };
+
+            class ScopeTimer {
+                Scope &scope_;
+                uint64_t items_;
+                std::chrono::steady_clock::time_point start_ = std::chrono::steady_clock::now();
+
+              public:
+                ScopeTimer(Scope &scope, uint64_t items) : scope_(scope), items_(items) {}
+                ScopeTimer(const ScopeTimer &) = delete;
+                ScopeTimer &operator=(const ScopeTimer &) = delete;
+
+                ~ScopeTimer() {
+                    const auto elapsed = std::chrono::steady_clock::now() - start_;
+                    scope_.record(
+                        static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()),
+                        items_);
+                }
+            };
+
+        } // namespace detail
+
+        // Record `n` conversions by hand (code paths that convert without going through fromRGB / to_rgb)
+        inline void count(Counter counter, uint64_t n) { detail::count(counter, n); }
+
+        // Everything recorded since start-up or the last reset(), summed over all threads
+        inline Stats snapshot() {
+            detail::Registry &r = detail::registry();
+            std::lock_guard<std::mutex> lock(r.mutex);
+            Stats stats;
+            const auto totals = r.totals();
+            for (size_t i = 0; i < COUNTER_COUNT; ++i) {
+                stats.conversions[i] = totals[i] - r.baseline[i];
+            }
+            for (const detail::Scope *scope : r.scopes) {
+                auto it = std::find_if(stats.scopes.begin(), stats.scopes.end(),
+                                       [scope](const ScopeStats &s) { return s.name == scope->name(); });
+                if (it == stats.scopes.end()) {
+                    stats.scopes.push_back(ScopeStats{scope->name()});
+                    it = stats.scopes.end() - 1;
+                }
+                it->calls += scope->calls.load(std::memory_order_relaxed);
+                it->items += scope->items.load(std::memory_order_relaxed);
+                it->max_items = std::max(it->max_items, scope->max_items.load(std::memory_order_relaxed));
+                it->total_ns += scope->total_ns.load(std::memory_order_relaxed);
+                it->max_ns = std::max(it->max_ns, scope->max_ns.load(std::memory_order_relaxed));
+            }
+            std::erase_if(stats.scopes, [](const ScopeStats &s) { return s.calls == 0; });
+            std::sort(stats.scopes.begin(), stats.scopes.end(),
+                      [](const ScopeStats &a, const ScopeStats &b) { return a.total_ns > b.total_ns; });
+            return stats;
+        }
+
+        // Start counting from zero again; calls still running on other threads may land on either side
+        inline void reset() {
+            detail::Registry &r = detail::registry();
+            std::lock_guard<std::mutex> lock(r.mutex);
+            r.baseline = r.totals();
+            for (detail::Scope *scope : r.scopes) {
+                scope->reset();
+            }
+        }
+
+#else
+
+        inline void count(Counter, uint64_t) {}
+        inline Stats snapshot() { return {}; }
+        inline void reset() {}
+
+#endif
+
+    } // namespace instrumentation
+} // namespace pigment
+
+#ifdef PIGMENT_ENABLE_INSTRUMENTATION
+#define PIGMENT_INSTRUMENTATION_CONCAT_(a, b) a##b
+#define PIGMENT_INSTRUMENTATION_CONCAT(a, b) PIGMENT_INSTRUMENTATION_CONCAT_(a, b)
+// Count `n` conversions of kind `counter` (an instrumentation::Counter enumerator name)
+#define PIGMENT_COUNT_N(counter, n)                                                                                    \
+    ::pigment::instrumentation::count(::pigment::instrumentation::Counter::counter, (n))
+#define PIGMENT_COUNT(counter) PIGMENT_COUNT_N(counter, 1)
+// Time the rest of the enclosing block as entry point `name` (a string literal), optionally with a batch size
+#define PIGMENT_SCOPE_N(name, items)                                                                                   \
+    static ::pigment::instrumentation::detail::Scope PIGMENT_INSTRUMENTATION_CONCAT(pigment_scope_, __LINE__){name}; \
+    const ::pigment::instrumentation::detail::ScopeTimer PIGMENT_INSTRUMENTATION_CONCAT(pigment_timer_, __LINE__)(    \
+        PIGMENT_INSTRUMENTATION_CONCAT(pigment_scope_, __LINE__), static_cast<uint64_t>(items))
+#define PIGMENT_SCOPE(name) PIGMENT_SCOPE_N(name, 0)
+#else
+#define PIGMENT_COUNT_N(counter, n) ((void)0)
+#define PIGMENT_COUNT(counter) ((void)0)
+#define PIGMENT_SCOPE_N(name, items) ((void)0)
+#define PIGMENT_SCOPE(name) ((void)0)
+#endif
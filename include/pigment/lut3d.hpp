@@ -0,0 +1,235 @@
+#pragma once
+
+#include "planar.hpp"
+#include "types_basic.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace pigment {
+
+    /**
+     * @brief RGB -> RGB lookup cube baked from an arbitrary color function
+     *
+     * Bake any chain of conversions once (e.g. LAB lightness shift + gamut clamp + back to RGB), then apply it
+     * per pixel by interpolating between the eight surrounding lattice nodes instead of evaluating the chain.
+     * Lattice node i sits at the 8-bit level round(i * 255 / (size - 1)), which is where the baked function is
+     * evaluated, and lookups interpolate between those same levels, so node inputs reproduce exactly.
+     * Alpha is not part of the cube and passes through unchanged.
+     */
+    class Lut3D {
+      public:
+        enum class Interpolation { TRILINEAR, TETRAHEDRAL };
+
+        // Common cube sizes
+        static constexpr size_t SMALL = 17;
+        static constexpr size_t MEDIUM = 33;
+        static constexpr size_t LARGE = 65;
+
+      private:
+        size_t size_ = 0;
+        std::vector<float> nodes_; // r, g, b per node; red varies fastest, then green, then blue
+
+        // Per input value: lower lattice index and fractional position inside the cell
+        std::array<uint32_t, 256> cell_{};
+        std::array<float, 256> frac_{};
+
+        // 8-bit input level of lattice index i; strictly increasing since the spacing is at least 1
+        static uint32_t level(size_t i, size_t size) {
+            return static_cast<uint32_t>(static_cast<double>(i) * 255.0 / static_cast<double>(size - 1) + 0.5);
+        }
+
+        // Weights come from the rounded levels the nodes were baked at, not from the ideal spacing
+        void build_axis() {
+            uint32_t lo = 0;
+            for (uint32_t v = 0; v < 256; ++v) {
+                while (lo + 2 < size_ && level(lo + 1, size_) <= v) {
+                    ++lo;
+                }
+                const uint32_t begin = level(lo, size_), end = level(lo + 1, size_);
+                cell_[v] = lo;
+                frac_[v] = static_cast<float>(v - begin) / static_cast<float>(end - begin);
+            }
+        }
+
+        const float *node(size_t r, size_t g, size_t b) const { return &nodes_[((b * size_ + g) * size_ + r) * 3]; }
+
+        void check_baked() const {
+            if (empty()) {
+                throw std::invalid_argument("Cannot apply an empty LUT");
+            }
+        }
+
+        static uint8_t to_byte(float v) { return static_cast<uint8_t>(std::clamp(v, 0.0f, 255.0f) + 0.5f); }
+
+        void lookup_trilinear(uint8_t r, uint8_t g, uint8_t b, float out[3]) const {
+            size_t r0 = cell_[r], g0 = cell_[g], b0 = cell_[b];
+            float fr = frac_[r], fg = frac_[g], fb = frac_[b];
+            const float *c000 = node(r0, g0, b0), *c100 = node(r0 + 1, g0, b0);
+            const float *c010 = node(r0, g0 + 1, b0), *c110 = node(r0 + 1, g0 + 1, b0);
+            const float *c001 = node(r0, g0, b0 + 1), *c101 = node(r0 + 1, g0, b0 + 1);
+            const float *c011 = node(r0, g0 + 1, b0 + 1), *c111 = node(r0 + 1, g0 + 1, b0 + 1);
+            for (int c = 0; c < 3; ++c) {
+                float x00 = c000[c] + (c100[c] - c000[c]) * fr;
+                float x10 = c010[c] + (c110[c] - c010[c]) * fr;
+                float x01 = c001[c] + (c101[c] - c001[c]) * fr;
+                float x11 = c011[c] + (c111[c] - c011[c]) * fr;
+                float y0 = x00 + (x10 - x00) * fg;
+                float y1 = x01 + (x11 - x01) * fg;
+                out[c] = y0 + (y1 - y0) * fb;
+            }
+        }
+
+        // Split the cell into six tetrahedra along its main diagonal; only four nodes are read per pixel
+        void lookup_tetrahedral(uint8_t r, uint8_t g, uint8_t b, float out[3]) const {
+            size_t r0 = cell_[r], g0 = cell_[g], b0 = cell_[b];
+            float fr = frac_[r], fg = frac_[g], fb = frac_[b];
+            const float *c000 = node(r0, g0, b0);
+            const float *c111 = node(r0 + 1, g0 + 1, b0 + 1);
+            const float *p1;
+            const float *p2;
+            float w0, w1, w2, w3;
+            if (fr > fg) {
+                if (fg > fb) {
+                    p1 = node(r0 + 1, g0, b0);
+                    p2 = node(r0 + 1, g0 + 1, b0);
+                    w0 = 1.0f - fr, w1 = fr - fg, w2 = fg - fb, w3 = fb;
+                } else if (fr > fb) {
+                    p1 = node(r0 + 1, g0, b0);
+                    p2 = node(r0 + 1, g0, b0 + 1);
+                    w0 = 1.0f - fr, w1 = fr - fb, w2 = fb - fg, w3 = fg;
+                } else {
+                    p1 = node(r0, g0, b0 + 1);
+                    p2 = node(r0 + 1, g0, b0 + 1);
+                    w0 = 1.0f - fb, w1 = fb - fr, w2 = fr - fg, w3 = fg;
+                }
+            } else {
+                if (fb > fg) {
+                    p1 = node(r0, g0, b0 + 1);
+                    p2 = node(r0, g0 + 1, b0 + 1);
+                    w0 = 1.0f - fb, w1 = fb - fg, w2 = fg - fr, w3 = fr;
+                } else if (fb > fr) {
+                    p1 = node(r0, g0 + 1, b0);
+                    p2 = node(r0, g0 + 1, b0 + 1);
+                    w0 = 1.0f - fg, w1 = fg - fb, w2 = fb - fr, w3 = fr;
+                } else {
+                    p1 = node(r0, g0 + 1, b0);
+                    p2 = node(r0 + 1, g0 + 1, b0);
+                    w0 = 1.0f - fg, w1 = fg - fr, w2 = fr - fb, w3 = fb;
+                }
+            }
+            for (int c = 0; c < 3; ++c) {
+                out[c] = w0 * c000[c] + w1 * p1[c] + w2 * p2[c] + w3 * c111[c];
+            }
+        }
+
+        template <Interpolation Mode> void lookup(uint8_t r, uint8_t g, uint8_t b, float out[3]) const {
+            if constexpr (Mode == Interpolation::TETRAHEDRAL) {
+                lookup_tetrahedral(r, g, b, out);
+            } else {
+                lookup_trilinear(r, g, b, out);
+            }
+        }
+
+        template <Interpolation Mode> void apply_span(std::span<const RGB> src, std::span<RGB> dst) const {
+            float v[3];
+            for (size_t i = 0; i < src.size(); ++i) {
+                const RGB &c = src[i];
+                lookup<Mode>(c.r(), c.g(), c.b(), v);
+                dst[i] = RGB(to_byte(v[0]), to_byte(v[1]), to_byte(v[2]), c.a());
+            }
+        }
+
+        template <Interpolation Mode> void apply_planes(uint8_t *r, uint8_t *g, uint8_t *b, size_t n) const {
+            float v[3];
+            for (size_t x = 0; x < n; ++x) {
+                lookup<Mode>(r[x], g[x], b[x], v);
+                r[x] = to_byte(v[0]);
+                g[x] = to_byte(v[1]);
+                b[x] = to_byte(v[2]);
+            }
+        }
+
+      public:
+        Lut3D() = default;
+
+        // Bake `fn` (RGB -> RGB) into a size^3 cube; size must be in [2, 256]
+        template <typename Fn> static Lut3D bake(Fn &&fn, size_t size = MEDIUM) {
+            PIGMENT_SCOPE_N("Lut3D::bake", size * size * size);
+            if (size < 2 || size > 256) {
+                throw std::invalid_argument("LUT size must be between 2 and 256");
+            }
+            Lut3D lut;
+            lut.size_ = size;
+            lut.nodes_.resize(size * size * size * 3);
+            auto at = [size](size_t i) { return static_cast<uint8_t>(level(i, size)); };
+
+            float *out = lut.nodes_.data();
+            for (size_t b = 0; b < size; ++b) {
+                for (size_t g = 0; g < size; ++g) {
+                    for (size_t r = 0; r < size; ++r) {
+                        RGB mapped = fn(RGB(at(r), at(g), at(b)));
+                        *out++ = mapped.r();
+                        *out++ = mapped.g();
+                        *out++ = mapped.b();
+                    }
+                }
+            }
+            lut.build_axis();
+            return lut;
+        }
+
+        size_t size() const { return size_; }
+        bool empty() const { return size_ == 0; }
+
+        // Node values (0-255 floats, three per node)
+        const std::vector<float> &nodes() const { return nodes_; }
+
+        // Single-pixel lookup
+        RGB apply(const RGB &color, Interpolation mode = Interpolation::TETRAHEDRAL) const {
+            check_baked();
+            float v[3];
+            if (mode == Interpolation::TETRAHEDRAL) {
+                lookup<Interpolation::TETRAHEDRAL>(color.r(), color.g(), color.b(), v);
+            } else {
+                lookup<Interpolation::TRILINEAR>(color.r(), color.g(), color.b(), v);
+            }
+            return RGB(to_byte(v[0]), to_byte(v[1]), to_byte(v[2]), color.a());
+        }
+
+        // Batch lookup; `dst` may alias `src`
+        void apply(std::span<const RGB> src, std::span<RGB> dst,
+                   Interpolation mode = Interpolation::TETRAHEDRAL) const {
+            PIGMENT_SCOPE_N("Lut3D::apply", src.size());
+            if (dst.size() < src.size()) {
+                throw std::invalid_argument("Destination span is smaller than source span");
+            }
+            check_baked();
+            if (mode == Interpolation::TETRAHEDRAL) {
+                apply_span<Interpolation::TETRAHEDRAL>(src, dst);
+            } else {
+                apply_span<Interpolation::TRILINEAR>(src, dst);
+            }
+        }
+
+        // In-place lookup over the r, g, b planes (alpha plane untouched)
+        void apply(PlanarImage<RGB> &image, Interpolation mode = Interpolation::TETRAHEDRAL) const {
+            check_baked();
+            for (size_t y = 0; y < image.height(); ++y) {
+                uint8_t *r = image.row(0, y).data();
+                uint8_t *g = image.row(1, y).data();
+                uint8_t *b = image.row(2, y).data();
+                if (mode == Interpolation::TETRAHEDRAL) {
+                    apply_planes<Interpolation::TETRAHEDRAL>(r, g, b, image.width());
+                } else {
+                    apply_planes<Interpolation::TRILINEAR>(r, g, b, image.width());
+                }
+            }
+        }
+    };
+
+} // namespace pigment
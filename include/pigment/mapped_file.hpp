@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define PIGMENT_HAS_MMAP 1
+#endif
+
+namespace pigment {
+
+    /**
+     * @brief Read-only view of a whole file
+     *
+     * Memory-maps the file where mmap is available (pages are faulted in on first touch and shared between
+     * processes), otherwise reads it into an owned buffer. Move-only.
+     */
+    class MappedFile {
+      private:
+        const uint8_t *data_ = nullptr;
+        size_t size_ = 0;
+        std::vector<uint8_t> fallback_;
+
+        void release() {
+#ifdef PIGMENT_HAS_MMAP
+            if (data_ && fallback_.empty() && size_ > 0) {
+                ::munmap(const_cast<uint8_t *>(data_), size_);
+            }
+#endif
+            data_ = nullptr;
+            size_ = 0;
+            fallback_.clear();
+        }
+
+      public:
+        MappedFile() = default;
+
+        explicit MappedFile(const std::string &path) {
+#ifdef PIGMENT_HAS_MMAP
+            int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0) {
+                throw std::runtime_error("Cannot open file: " + path);
+            }
+            struct stat st;
+            if (::fstat(fd, &st) != 0) {
+                ::close(fd);
+                throw std::runtime_error("Cannot stat file: " + path);
+            }
+            size_ = static_cast<size_t>(st.st_size);
+            if (size_ > 0) {
+                void *mapped = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+                if (mapped == MAP_FAILED) {
+                    ::close(fd);
+                    size_ = 0;
+                    throw std::runtime_error("Cannot map file: " + path);
+                }
+                data_ = static_cast<const uint8_t *>(mapped);
+            }
+            ::close(fd);
+#else
+            std::ifstream in(path, std::ios::binary | std::ios::ate);
+            if (!in) {
+                throw std::runtime_error("Cannot open file: " + path);
+            }
+            fallback_.resize(static_cast<size_t>(in.tellg()));
+            in.seekg(0);
+            in.read(reinterpret_cast<char *>(fallback_.data()), static_cast<std::streamsize>(fallback_.size()));
+            data_ = fallback_.data();
+            size_ = fallback_.size();
+#endif
+        }
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        MappedFile(MappedFile &&other) noexcept { *this = std::move(other); }
+
+        MappedFile &operator=(MappedFile &&other) noexcept {
+            if (this != &other) {
+                release();
+                fallback_ = std::move(other.fallback_);
+                data_ = fallback_.empty() ? other.data_ : fallback_.data();
+                size_ = other.size_;
+                other.data_ = nullptr;
+                other.size_ = 0;
+            }
+            return *this;
+        }
+
+        ~MappedFile() { release(); }
+
+        const uint8_t *data() const { return data_; }
+        size_t size() const { return size_; }
+        bool is_open() const { return data_ != nullptr; }
+    };
+
+} // namespace pigment
@@ -1,175 +1,286 @@
 #pragma once
 
+#include "palette_index.hpp"
 #include "types_basic.hpp"
-#include <string>
-#include <unordered_map>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <utility>
 
 namespace pigment {
     namespace colors {
 
-        // Red and Pink Variations
-        // Encompasses various shades of red, from light pinks to deep crimsons
-        inline RGB indianred() { return RGB("#CD5C5C"); }
-        inline RGB lightcoral() { return RGB("#F08080"); }
-        inline RGB salmon() { return RGB("#FA8072"); }
-        inline RGB darksalmon() { return RGB("#E9967A"); }
-        inline RGB lightsalmon() { return RGB("#FFA07A"); }
-        inline RGB crimson() { return RGB("#DC143C"); }
-        inline RGB red() { return RGB("#FF0000"); }
-        inline RGB firebrick() { return RGB("#B22222"); }
-        inline RGB darkred() { return RGB("#8B0000"); }
-        inline RGB pink() { return RGB("#FFC0CB"); }
-        inline RGB lightpink() { return RGB("#FFB6C1"); }
-        inline RGB hotpink() { return RGB("#FF69B4"); }
-        inline RGB deeppink() { return RGB("#FF1493"); }
-        inline RGB mediumvioletred() { return RGB("#C71585"); }
-        inline RGB palevioletred() { return RGB("#DB7093"); }
-
-        // Orange and Yellow Hues
-        // Warm colors ranging from coral to golden yellows
-        inline RGB coral() { return RGB("#FF7F50"); }
-        inline RGB tomato() { return RGB("#FF6347"); }
-        inline RGB orangered() { return RGB("#FF4500"); }
-        inline RGB darkorange() { return RGB("#FF8C00"); }
-        inline RGB orange() { return RGB("#FFA500"); }
-        inline RGB gold() { return RGB("#FFD700"); }
-        inline RGB yellow() { return RGB("#FFFF00"); }
-        inline RGB lightyellow() { return RGB("#FFFFE0"); }
-        inline RGB lemonchiffon() { return RGB("#FFFACD"); }
-        inline RGB lightgoldenrodyellow() { return RGB("#FAFAD2"); }
-        inline RGB papayawhip() { return RGB("#FFEFD5"); }
-        inline RGB moccasin() { return RGB("#FFE4B5"); }
-        inline RGB peachpuff() { return RGB("#FFDAB9"); }
-        inline RGB palegoldenrod() { return RGB("#EEE8AA"); }
-        inline RGB khaki() { return RGB("#F0E68C"); }
-        inline RGB darkkhaki() { return RGB("#BDB76B"); }
-
-        // Purple and Violet Shades
-        // Range from light lavender to deep purple and indigo
-        inline RGB lavender() { return RGB("#E6E6FA"); }
-        inline RGB thistle() { return RGB("#D8BFD8"); }
-        inline RGB plum() { return RGB("#DDA0DD"); }
-        inline RGB violet() { return RGB("#EE82EE"); }
-        inline RGB orchid() { return RGB("#DA70D6"); }
-        inline RGB fuchsia() { return RGB("#FF00FF"); }
-        inline RGB magenta() { return RGB("#FF00FF"); }
-        inline RGB mediumorchid() { return RGB("#BA55D3"); }
-        inline RGB mediumpurple() { return RGB("#9370DB"); }
-        inline RGB blueviolet() { return RGB("#8A2BE2"); }
-        inline RGB darkviolet() { return RGB("#9400D3"); }
-        inline RGB darkorchid() { return RGB("#9932CC"); }
-        inline RGB darkmagenta() { return RGB("#8B008B"); }
-        inline RGB purple() { return RGB("#800080"); }
-        inline RGB rebeccapurple() { return RGB("#663399"); }
-        inline RGB indigo() { return RGB("#4B0082"); }
-
-        // Green Variations
-        // Full spectrum of greens from yellow-green to forest green
-        inline RGB greenyellow() { return RGB("#ADFF2F"); }
-        inline RGB chartreuse() { return RGB("#7FFF00"); }
-        inline RGB lawngreen() { return RGB("#7CFC00"); }
-        inline RGB lime() { return RGB("#00FF00"); }
-        inline RGB limegreen() { return RGB("#32CD32"); }
-        inline RGB palegreen() { return RGB("#98FB98"); }
-        inline RGB lightgreen() { return RGB("#90EE90"); }
-        inline RGB mediumspringgreen() { return RGB("#00FA9A"); }
-        inline RGB springgreen() { return RGB("#00FF7F"); }
-        inline RGB mediumseagreen() { return RGB("#3CB371"); }
-        inline RGB seagreen() { return RGB("#2E8B57"); }
-        inline RGB forestgreen() { return RGB("#228B22"); }
-        inline RGB green() { return RGB("#008000"); }
-        inline RGB darkgreen() { return RGB("#006400"); }
-        inline RGB yellowgreen() { return RGB("#9ACD32"); }
-        inline RGB olivedrab() { return RGB("#6B8E23"); }
-        inline RGB olive() { return RGB("#808000"); }
-        inline RGB darkolivegreen() { return RGB("#556B2F"); }
-
-        // Cyan and Turquoise Colors
-        // Aquatic colors ranging from light cyan to deep teal
-        inline RGB mediumaquamarine() { return RGB("#66CDAA"); }
-        inline RGB aqua() { return RGB("#00FFFF"); }
-        inline RGB cyan() { return RGB("#00FFFF"); }
-        inline RGB lightcyan() { return RGB("#E0FFFF"); }
-        inline RGB paleturquoise() { return RGB("#AFEEEE"); }
-        inline RGB aquamarine() { return RGB("#7FFFD4"); }
-        inline RGB turquoise() { return RGB("#40E0D0"); }
-        inline RGB mediumturquoise() { return RGB("#48D1CC"); }
-        inline RGB darkturquoise() { return RGB("#00CED1"); }
-        inline RGB lightseagreen() { return RGB("#20B2AA"); }
-        inline RGB cadetblue() { return RGB("#5F9EA0"); }
-        inline RGB darkcyan() { return RGB("#008B8B"); }
-        inline RGB teal() { return RGB("#008080"); }
-
-        // Blue Variations
-        // Complete range of blues from light to navy
-        inline RGB lightsteelblue() { return RGB("#B0C4DE"); }
-        inline RGB powderblue() { return RGB("#B0E0E6"); }
-        inline RGB lightblue() { return RGB("#ADD8E6"); }
-        inline RGB skyblue() { return RGB("#87CEEB"); }
-        inline RGB lightskyblue() { return RGB("#87CEFA"); }
-        inline RGB deepskyblue() { return RGB("#00BFFF"); }
-        inline RGB dodgerblue() { return RGB("#1E90FF"); }
-        inline RGB cornflowerblue() { return RGB("#6495ED"); }
-        inline RGB steelblue() { return RGB("#4682B4"); }
-        inline RGB royalblue() { return RGB("#4169E1"); }
-        inline RGB blue() { return RGB("#0000FF"); }
-        inline RGB mediumblue() { return RGB("#0000CD"); }
-        inline RGB darkblue() { return RGB("#00008B"); }
-        inline RGB navy() { return RGB("#000080"); }
-        inline RGB midnightblue() { return RGB("#191970"); }
-
-        // Brown and Earth Tones
-        // Natural earth-toned colors from light tan to deep brown
-        inline RGB cornsilk() { return RGB("#FFF8DC"); }
-        inline RGB blanchedalmond() { return RGB("#FFEBCD"); }
-        inline RGB bisque() { return RGB("#FFE4C4"); }
-        inline RGB navajowhite() { return RGB("#FFDEAD"); }
-        inline RGB wheat() { return RGB("#F5DEB3"); }
-        inline RGB burlywood() { return RGB("#DEB887"); }
-        inline RGB tan() { return RGB("#D2B48C"); }
-        inline RGB rosybrown() { return RGB("#BC8F8F"); }
-        inline RGB sandybrown() { return RGB("#F4A460"); }
-        inline RGB goldenrod() { return RGB("#DAA520"); }
-        inline RGB darkgoldenrod() { return RGB("#B8860B"); }
-        inline RGB peru() { return RGB("#CD853F"); }
-        inline RGB chocolate() { return RGB("#D2691E"); }
-        inline RGB saddlebrown() { return RGB("#8B4513"); }
-        inline RGB sienna() { return RGB("#A0522D"); }
-        inline RGB brown() { return RGB("#A52A2A"); }
-        inline RGB maroon() { return RGB("#800000"); }
-
-        // White and Off-White Shades
-        // Pure white and various warm and cool white tints
-        inline RGB white() { return RGB("#FFFFFF"); }
-        inline RGB snow() { return RGB("#FFFAFA"); }
-        inline RGB honeydew() { return RGB("#F0FFF0"); }
-        inline RGB mintcream() { return RGB("#F5FFFA"); }
-        inline RGB azure() { return RGB("#F0FFFF"); }
-        inline RGB aliceblue() { return RGB("#F0F8FF"); }
-        inline RGB ghostwhite() { return RGB("#F8F8FF"); }
-        inline RGB whitesmoke() { return RGB("#F5F5F5"); }
-        inline RGB seashell() { return RGB("#FFF5EE"); }
-        inline RGB beige() { return RGB("#F5F5DC"); }
-        inline RGB oldlace() { return RGB("#FDF5E6"); }
-        inline RGB floralwhite() { return RGB("#FFFAF0"); }
-        inline RGB ivory() { return RGB("#FFFFF0"); }
-        inline RGB antiquewhite() { return RGB("#FAEBD7"); }
-        inline RGB linen() { return RGB("#FAF0E6"); }
-        inline RGB lavenderblush() { return RGB("#FFF0F5"); }
-        inline RGB mistyrose() { return RGB("#FFE4E1"); }
-
-        // Gray Scale
-        // Complete range of grays from light to dark
-        inline RGB gainsboro() { return RGB("#DCDCDC"); }
-        inline RGB lightgray() { return RGB("#D3D3D3"); }
-        inline RGB silver() { return RGB("#C0C0C0"); }
-        inline RGB darkgray() { return RGB("#A9A9A9"); }
-        inline RGB gray() { return RGB("#808080"); }
-        inline RGB dimgray() { return RGB("#696969"); }
-        inline RGB lightslategray() { return RGB("#778899"); }
-        inline RGB slategray() { return RGB("#708090"); }
-        inline RGB darkslategray() { return RGB("#2F4F4F"); }
-        inline RGB black() { return RGB("#000000"); }
+        using literals::operator""_rgb;
+
+        // Every named color, grouped by hue: X(name, hex). The accessor functions below and TABLE are both
+        // expanded from this one list, so a name and its value cannot drift apart.
+#define PIGMENT_NAMED_COLORS(X)                                                                                        \
+    /* Red and Pink Variations */                                                                                      \
+    /* Encompasses various shades of red, from light pinks to deep crimsons */                                         \
+    X(indianred, "#CD5C5C")                                                                                            \
+    X(lightcoral, "#F08080")                                                                                           \
+    X(salmon, "#FA8072")                                                                                               \
+    X(darksalmon, "#E9967A")                                                                                           \
+    X(lightsalmon, "#FFA07A")                                                                                          \
+    X(crimson, "#DC143C")                                                                                              \
+    X(red, "#FF0000")                                                                                                  \
+    X(firebrick, "#B22222")                                                                                            \
+    X(darkred, "#8B0000")                                                                                              \
+    X(pink, "#FFC0CB")                                                                                                 \
+    X(lightpink, "#FFB6C1")                                                                                            \
+    X(hotpink, "#FF69B4")                                                                                              \
+    X(deeppink, "#FF1493")                                                                                             \
+    X(mediumvioletred, "#C71585")                                                                                      \
+    X(palevioletred, "#DB7093")                                                                                        \
+                                                                                                                       \
+    /* Orange and Yellow Hues */                                                                                       \
+    /* Warm colors ranging from coral to golden yellows */                                                             \
+    X(coral, "#FF7F50")                                                                                                \
+    X(tomato, "#FF6347")                                                                                               \
+    X(orangered, "#FF4500")                                                                                            \
+    X(darkorange, "#FF8C00")                                                                                           \
+    X(orange, "#FFA500")                                                                                               \
+    X(gold, "#FFD700")                                                                                                 \
+    X(yellow, "#FFFF00")                                                                                               \
+    X(lightyellow, "#FFFFE0")                                                                                          \
+    X(lemonchiffon, "#FFFACD")                                                                                         \
+    X(lightgoldenrodyellow, "#FAFAD2")                                                                                 \
+    X(papayawhip, "#FFEFD5")                                                                                           \
+    X(moccasin, "#FFE4B5")                                                                                             \
+    X(peachpuff, "#FFDAB9")                                                                                            \
+    X(palegoldenrod, "#EEE8AA")                                                                                        \
+    X(khaki, "#F0E68C")                                                                                                \
+    X(darkkhaki, "#BDB76B")                                                                                            \
+                                                                                                                       \
+    /* Purple and Violet Shades */                                                                                     \
+    /* Range from light lavender to deep purple and indigo */                                                          \
+    X(lavender, "#E6E6FA")                                                                                             \
+    X(thistle, "#D8BFD8")                                                                                              \
+    X(plum, "#DDA0DD")                                                                                                 \
+    X(violet, "#EE82EE")                                                                                               \
+    X(orchid, "#DA70D6")                                                                                               \
+    X(fuchsia, "#FF00FF")                                                                                              \
+    X(magenta, "#FF00FF")                                                                                              \
+    X(mediumorchid, "#BA55D3")                                                                                         \
+    X(mediumpurple, "#9370DB")                                                                                         \
+    X(blueviolet, "#8A2BE2")                                                                                           \
+    X(darkviolet, "#9400D3")                                                                                           \
+    X(darkorchid, "#9932CC")                                                                                           \
+    X(darkmagenta, "#8B008B")                                                                                          \
+    X(purple, "#800080")                                                                                               \
+    X(rebeccapurple, "#663399")                                                                                        \
+    X(indigo, "#4B0082")                                                                                               \
+                                                                                                                       \
+    /* Green Variations */                                                                                             \
+    /* Full spectrum of greens from yellow-green to forest green */                                                    \
+    X(greenyellow, "#ADFF2F")                                                                                          \
+    X(chartreuse, "#7FFF00")                                                                                           \
+    X(lawngreen, "#7CFC00")                                                                                            \
+    X(lime, "#00FF00")                                                                                                 \
+    X(limegreen, "#32CD32")                                                                                            \
+    X(palegreen, "#98FB98")                                                                                            \
+    X(lightgreen, "#90EE90")                                                                                           \
+    X(mediumspringgreen, "#00FA9A")                                                                                    \
+    X(springgreen, "#00FF7F")                                                                                          \
+    X(mediumseagreen, "#3CB371")                                                                                       \
+    X(seagreen, "#2E8B57")                                                                                             \
+    X(forestgreen, "#228B22")                                                                                          \
+    X(green, "#008000")                                                                                                \
+    X(darkgreen, "#006400")                                                                                            \
+    X(yellowgreen, "#9ACD32")                                                                                          \
+    X(olivedrab, "#6B8E23")                                                                                            \
+    X(olive, "#808000")                                                                                                \
+    X(darkolivegreen, "#556B2F")                                                                                       \
+                                                                                                                       \
+    /* Cyan and Turquoise Colors */                                                                                    \
+    /* Aquatic colors ranging from light cyan to deep teal */                                                          \
+    X(mediumaquamarine, "#66CDAA")                                                                                     \
+    X(aqua, "#00FFFF")                                                                                                 \
+    X(cyan, "#00FFFF")                                                                                                 \
+    X(lightcyan, "#E0FFFF")                                                                                            \
+    X(paleturquoise, "#AFEEEE")                                                                                        \
+    X(aquamarine, "#7FFFD4")                                                                                           \
+    X(turquoise, "#40E0D0")                                                                                            \
+    X(mediumturquoise, "#48D1CC")                                                                                      \
+    X(darkturquoise, "#00CED1")                                                                                        \
+    X(lightseagreen, "#20B2AA")                                                                                        \
+    X(cadetblue, "#5F9EA0")                                                                                            \
+    X(darkcyan, "#008B8B")                                                                                             \
+    X(teal, "#008080")                                                                                                 \
+                                                                                                                       \
+    /* Blue Variations */                                                                                              \
+    /* Complete range of blues from light to navy */                                                                   \
+    X(lightsteelblue, "#B0C4DE")                                                                                       \
+    X(powderblue, "#B0E0E6")                                                                                           \
+    X(lightblue, "#ADD8E6")                                                                                            \
+    X(skyblue, "#87CEEB")                                                                                              \
+    X(lightskyblue, "#87CEFA")                                                                                         \
+    X(deepskyblue, "#00BFFF")                                                                                          \
+    X(dodgerblue, "#1E90FF")                                                                                           \
+    X(cornflowerblue, "#6495ED")                                                                                       \
+    X(steelblue, "#4682B4")                                                                                            \
+    X(royalblue, "#4169E1")                                                                                            \
+    X(blue, "#0000FF")                                                                                                 \
+    X(mediumblue, "#0000CD")                                                                                           \
+    X(darkblue, "#00008B")                                                                                             \
+    X(navy, "#000080")                                                                                                 \
+    X(midnightblue, "#191970")                                                                                         \
+                                                                                                                       \
+    /* Brown and Earth Tones */                                                                                        \
+    /* Natural earth-toned colors from light tan to deep brown */                                                      \
+    X(cornsilk, "#FFF8DC")                                                                                             \
+    X(blanchedalmond, "#FFEBCD")                                                                                       \
+    X(bisque, "#FFE4C4")                                                                                               \
+    X(navajowhite, "#FFDEAD")                                                                                          \
+    X(wheat, "#F5DEB3")                                                                                                \
+    X(burlywood, "#DEB887")                                                                                            \
+    X(tan, "#D2B48C")                                                                                                  \
+    X(rosybrown, "#BC8F8F")                                                                                            \
+    X(sandybrown, "#F4A460")                                                                                           \
+    X(goldenrod, "#DAA520")                                                                                            \
+    X(darkgoldenrod, "#B8860B")                                                                                        \
+    X(peru, "#CD853F")                                                                                                 \
+    X(chocolate, "#D2691E")                                                                                            \
+    X(saddlebrown, "#8B4513")                                                                                          \
+    X(sienna, "#A0522D")                                                                                               \
+    X(brown, "#A52A2A")                                                                                                \
+    X(maroon, "#800000")                                                                                               \
+                                                                                                                       \
+    /* White and Off-White Shades */                                                                                   \
+    /* Pure white and various warm and cool white tints */                                                             \
+    X(white, "#FFFFFF")                                                                                                \
+    X(snow, "#FFFAFA")                                                                                                 \
+    X(honeydew, "#F0FFF0")                                                                                             \
+    X(mintcream, "#F5FFFA")                                                                                            \
+    X(azure, "#F0FFFF")                                                                                                \
+    X(aliceblue, "#F0F8FF")                                                                                            \
+    X(ghostwhite, "#F8F8FF")                                                                                           \
+    X(whitesmoke, "#F5F5F5")                                                                                           \
+    X(seashell, "#FFF5EE")                                                                                             \
+    X(beige, "#F5F5DC")                                                                                                \
+    X(oldlace, "#FDF5E6")                                                                                              \
+    X(floralwhite, "#FFFAF0")                                                                                          \
+    X(ivory, "#FFFFF0")                                                                                                \
+    X(antiquewhite, "#FAEBD7")                                                                                         \
+    X(linen, "#FAF0E6")                                                                                                \
+    X(lavenderblush, "#FFF0F5")                                                                                        \
+    X(mistyrose, "#FFE4E1")                                                                                            \
+                                                                                                                       \
+    /* Gray Scale */                                                                                                   \
+    /* Complete range of grays from light to dark */                                                                   \
+    X(gainsboro, "#DCDCDC")                                                                                            \
+    X(lightgray, "#D3D3D3")                                                                                            \
+    X(silver, "#C0C0C0")                                                                                               \
+    X(darkgray, "#A9A9A9")                                                                                             \
+    X(gray, "#808080")                                                                                                 \
+    X(dimgray, "#696969")                                                                                              \
+    X(lightslategray, "#778899")                                                                                       \
+    X(slategray, "#708090")                                                                                            \
+    X(darkslategray, "#2F4F4F")                                                                                        \
+    X(black, "#000000")
+
+#define PIGMENT_NAMED_COLOR_FUNCTION(name, hex)                                                                        \
+    constexpr RGB name() { return literals::operator""_rgb(hex, sizeof(hex) - 1); }
+        PIGMENT_NAMED_COLORS(PIGMENT_NAMED_COLOR_FUNCTION)
+#undef PIGMENT_NAMED_COLOR_FUNCTION
+
+        /**
+         * @brief A CSS / X11 color name and its value
+         */
+        struct NamedColor {
+            std::string_view name;
+            RGB color;
+        };
+
+        namespace named_detail {
+
+#define PIGMENT_NAMED_COLOR_ENTRY(name, hex) NamedColor{#name, name()},
+            inline constexpr NamedColor UNSORTED[] = {PIGMENT_NAMED_COLORS(PIGMENT_NAMED_COLOR_ENTRY)};
+#undef PIGMENT_NAMED_COLOR_ENTRY
+#undef PIGMENT_NAMED_COLORS
+
+            // RGB has no constexpr default constructor, so sort positions and gather the entries in that order
+            inline constexpr auto SORTED_ORDER = [] {
+                std::array<size_t, std::size(UNSORTED)> order{};
+                for (size_t i = 0; i < order.size(); ++i) {
+                    order[i] = i;
+                }
+                std::sort(order.begin(), order.end(),
+                          [](size_t a, size_t b) { return UNSORTED[a].name < UNSORTED[b].name; });
+                return order;
+            }();
+
+            template <size_t... I>
+            constexpr std::array<NamedColor, sizeof...(I)> sorted_table(std::index_sequence<I...>) {
+                return {{UNSORTED[SORTED_ORDER[I]]...}};
+            }
+
+        } // namespace named_detail
+
+        // Every named color, sorted by name so lookup() can binary search; built at compile time
+        inline constexpr auto TABLE =
+            named_detail::sorted_table(std::make_index_sequence<std::size(named_detail::UNSORTED)>{});
+        static_assert(TABLE.size() == 137, "colors::TABLE should hold the 137 CSS / X11 names");
+
+        namespace named_detail {
+
+            constexpr char to_lower(char c) { return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c; }
+
+            // Case-insensitive ordering without building a lowered copy
+            constexpr bool less_ci(std::string_view a, std::string_view b) {
+                const size_t n = std::min(a.size(), b.size());
+                for (size_t i = 0; i < n; ++i) {
+                    const char ca = to_lower(a[i]), cb = to_lower(b[i]);
+                    if (ca != cb) {
+                        return ca < cb;
+                    }
+                }
+                return a.size() < b.size();
+            }
+
+            constexpr bool table_sorted() {
+                for (size_t i = 1; i < TABLE.size(); ++i) {
+                    if (!less_ci(TABLE[i - 1].name, TABLE[i].name)) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+            static_assert(table_sorted(), "colors::TABLE must stay sorted by name without duplicates");
+
+            inline const PaletteIndex &index() {
+                static const PaletteIndex palette_index = [] {
+                    std::array<RGB, TABLE.size()> colors;
+                    for (size_t i = 0; i < TABLE.size(); ++i) {
+                        colors[i] = TABLE[i].color;
+                    }
+                    return PaletteIndex(std::span<const RGB>(colors));
+                }();
+                return palette_index;
+            }
+
+        } // namespace named_detail
+
+        // Color for a CSS name (case-insensitive), e.g. lookup("SkyBlue"); O(log N), no allocation
+        constexpr std::optional<RGB> lookup(std::string_view name) {
+            auto it = std::lower_bound(
+                TABLE.begin(), TABLE.end(), name,
+                [](const NamedColor &entry, std::string_view key) { return named_detail::less_ci(entry.name, key); });
+            if (it == TABLE.end() || named_detail::less_ci(name, it->name)) {
+                return std::nullopt;
+            }
+            return it->color;
+        }
+
+        // Name of the perceptually closest named color (CIE76 in LAB); aliases resolve to the first name
+        inline std::string_view nearest_name(const RGB &color) {
+            return TABLE[named_detail::index().nearest(color)].name;
+        }
 
     } // namespace colors
 } // namespace pigment
\ No newline at end of file
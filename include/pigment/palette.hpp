@@ -1,10 +1,14 @@
 #pragma once
 
+#include "histogram.hpp"
+#include "random.hpp"
 #include "types_basic.hpp"
 #include "types_hsl.hpp"
 
 #include <algorithm>
+#include <iterator>
 #include <random>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -16,7 +20,7 @@ namespace pigment {
 
       public:
         Palette() = default;
-        Palette(const std::vector<RGB> &colors) : colors_(colors) {}
+        Palette(std::vector<RGB> colors) : colors_(std::move(colors)) {}
         Palette(std::initializer_list<RGB> colors) : colors_(colors) {}
 
         // Add colors
@@ -42,41 +46,68 @@ namespace pigment {
         auto end() const { return colors_.end(); }
 
         // Get random color from palette
-        RGB random() const {
+        template <typename URBG> RGB random(URBG &gen) const {
             if (colors_.empty())
                 return RGB::black();
 
-            static std::random_device rd;
-            static std::mt19937 gen(rd());
             std::uniform_int_distribution<size_t> dist(0, colors_.size() - 1);
             return colors_[dist(gen)];
         }
 
+        RGB random() const { return random(rng::engine()); }
+
+        // Generators below come in three forms: returning a Palette, writing `count` colors through an output
+        // iterator (returns the iterator past the last color), and filling a caller-owned span (count =
+        // span size). The last two never allocate. Random ones take an optional generator and otherwise draw
+        // from the calling thread's rng::engine().
+
+        // The `count` most frequent colors of a histogram (bin averages), most frequent first
+        static Palette from_histogram(const Histogram &histogram, size_t count) {
+            Palette palette;
+            for (const Histogram::Bin &bin : histogram.top(count)) {
+                palette.add(bin.mean());
+            }
+            return palette;
+        }
+
         // Create gradient between two colors
+        template <std::output_iterator<RGB> OutputIt>
+        static OutputIt gradient(const RGB &start, const RGB &end, size_t steps, OutputIt out) {
+            for (size_t i = 0; i < steps; ++i) {
+                double ratio = static_cast<double>(i) / (steps - 1);
+                *out++ = start.mix(end, ratio);
+            }
+            return out;
+        }
+
+        static void gradient(const RGB &start, const RGB &end, std::span<RGB> out) {
+            gradient(start, end, out.size(), out.begin());
+        }
+
         static Palette gradient(const RGB &start, const RGB &end, size_t steps) {
             std::vector<RGB> colors;
             colors.reserve(steps);
+            gradient(start, end, steps, std::back_inserter(colors));
+            return Palette(std::move(colors));
+        }
 
-            for (size_t i = 0; i < steps; ++i) {
-                double ratio = static_cast<double>(i) / (steps - 1);
-                colors.push_back(start.mix(end, ratio));
+        // Create multi-color gradient, (colors.size() - 1) * steps_per_segment colors in total
+        template <std::output_iterator<RGB> OutputIt>
+        static OutputIt gradient(std::span<const RGB> colors, size_t steps_per_segment, OutputIt out) {
+            for (size_t i = 0; i + 1 < colors.size(); ++i) {
+                out = gradient(colors[i], colors[i + 1], steps_per_segment, out);
             }
-
-            return Palette(colors);
+            return out;
         }
 
-        // Create multi-color gradient
         static Palette gradient(const std::vector<RGB> &colors, size_t steps_per_segment) {
             if (colors.size() < 2)
                 return Palette();
 
-            Palette result;
-            for (size_t i = 0; i < colors.size() - 1; ++i) {
-                auto segment = gradient(colors[i], colors[i + 1], steps_per_segment);
-                result.add(segment.colors_);
-            }
-
-            return result;
+            std::vector<RGB> result;
+            result.reserve((colors.size() - 1) * steps_per_segment);
+            gradient(std::span<const RGB>(colors), steps_per_segment, std::back_inserter(result));
+            return Palette(std::move(result));
         }
 
         // Predefined palettes
@@ -121,31 +152,49 @@ namespace pigment {
             });
         }
 
-        static Palette monochromatic(const RGB &base, size_t count = 5) {
+        template <std::output_iterator<RGB> OutputIt>
+        static OutputIt monochromatic(const RGB &base, size_t count, OutputIt out) {
             HSL hsl = HSL::fromRGB(base);
-            std::vector<RGB> colors;
 
             for (size_t i = 0; i < count; ++i) {
                 double lightness = 0.2 + (0.6 * i / (count - 1));
-                colors.push_back(HSL(hsl.get_h(), hsl.get_s(), lightness, hsl.alpha).to_rgb());
+                *out++ = HSL(hsl.get_h(), hsl.get_s(), lightness, hsl.alpha).to_rgb();
             }
+            return out;
+        }
 
-            return Palette(colors);
+        static void monochromatic(const RGB &base, std::span<RGB> out) { monochromatic(base, out.size(), out.begin()); }
+
+        static Palette monochromatic(const RGB &base, size_t count = 5) {
+            std::vector<RGB> colors;
+            colors.reserve(count);
+            monochromatic(base, count, std::back_inserter(colors));
+            return Palette(std::move(colors));
         }
 
-        static Palette analogous(const RGB &base, size_t count = 5, double range = 60.0) {
+        template <std::output_iterator<RGB> OutputIt>
+        static OutputIt analogous(const RGB &base, size_t count, double range, OutputIt out) {
             HSL hsl = HSL::fromRGB(base);
-            std::vector<RGB> colors;
 
             double step = range / (count - 1);
             double start_hue = hsl.get_h() - range / 2.0;
 
             for (size_t i = 0; i < count; ++i) {
                 double hue = start_hue + (step * i);
-                colors.push_back(HSL(hue, hsl.get_s(), hsl.get_l(), hsl.alpha).to_rgb());
+                *out++ = HSL(hue, hsl.get_s(), hsl.get_l(), hsl.alpha).to_rgb();
             }
+            return out;
+        }
 
-            return Palette(colors);
+        static void analogous(const RGB &base, std::span<RGB> out, double range = 60.0) {
+            analogous(base, out.size(), range, out.begin());
+        }
+
+        static Palette analogous(const RGB &base, size_t count = 5, double range = 60.0) {
+            std::vector<RGB> colors;
+            colors.reserve(count);
+            analogous(base, count, range, std::back_inserter(colors));
+            return Palette(std::move(colors));
         }
 
         static Palette complementary(const RGB &base) {
@@ -165,34 +214,60 @@ namespace pigment {
             return Palette(colors);
         }
 
-        static Palette pastel(size_t count = 8) {
-            std::vector<RGB> colors;
-            static std::random_device rd;
-            static std::mt19937 gen(rd());
+      private:
+        // `count` colors of random hue at a fixed saturation and lightness
+        template <typename OutputIt, typename URBG>
+        static OutputIt random_hues(size_t count, double saturation, double lightness, OutputIt out, URBG &gen) {
             std::uniform_real_distribution<double> hue_dist(0.0, 360.0);
 
             for (size_t i = 0; i < count; ++i) {
-                HSL hsl(hue_dist(gen), 0.3, 0.8); // Low saturation, high lightness
-                colors.push_back(hsl.to_rgb());
+                *out++ = HSL(hue_dist(gen), saturation, lightness).to_rgb();
             }
-
-            return Palette(colors);
+            return out;
         }
 
-        static Palette vibrant(size_t count = 8) {
+        template <typename URBG> static Palette random_hues(size_t count, double saturation, double lightness,
+                                                            URBG &gen) {
             std::vector<RGB> colors;
-            static std::random_device rd;
-            static std::mt19937 gen(rd());
-            std::uniform_real_distribution<double> hue_dist(0.0, 360.0);
+            colors.reserve(count);
+            random_hues(count, saturation, lightness, std::back_inserter(colors), gen);
+            return Palette(std::move(colors));
+        }
 
-            for (size_t i = 0; i < count; ++i) {
-                HSL hsl(hue_dist(gen), 0.8, 0.5); // High saturation, medium lightness
-                colors.push_back(hsl.to_rgb());
-            }
+        static constexpr double PASTEL_SATURATION = 0.3, PASTEL_LIGHTNESS = 0.8;   // Low saturation, high lightness
+        static constexpr double VIBRANT_SATURATION = 0.8, VIBRANT_LIGHTNESS = 0.5; // High saturation, medium lightness
 
-            return Palette(colors);
+      public:
+        template <std::output_iterator<RGB> OutputIt, typename URBG = rng::Engine>
+        static OutputIt pastel(size_t count, OutputIt out, URBG &gen = rng::engine()) {
+            return random_hues(count, PASTEL_SATURATION, PASTEL_LIGHTNESS, out, gen);
+        }
+
+        template <typename URBG = rng::Engine> static void pastel(std::span<RGB> out, URBG &gen = rng::engine()) {
+            random_hues(out.size(), PASTEL_SATURATION, PASTEL_LIGHTNESS, out.begin(), gen);
+        }
+
+        template <typename URBG> static Palette pastel(size_t count, URBG &gen) {
+            return random_hues(count, PASTEL_SATURATION, PASTEL_LIGHTNESS, gen);
+        }
+
+        static Palette pastel(size_t count = 8) { return pastel(count, rng::engine()); }
+
+        template <std::output_iterator<RGB> OutputIt, typename URBG = rng::Engine>
+        static OutputIt vibrant(size_t count, OutputIt out, URBG &gen = rng::engine()) {
+            return random_hues(count, VIBRANT_SATURATION, VIBRANT_LIGHTNESS, out, gen);
+        }
+
+        template <typename URBG = rng::Engine> static void vibrant(std::span<RGB> out, URBG &gen = rng::engine()) {
+            random_hues(out.size(), VIBRANT_SATURATION, VIBRANT_LIGHTNESS, out.begin(), gen);
         }
 
+        template <typename URBG> static Palette vibrant(size_t count, URBG &gen) {
+            return random_hues(count, VIBRANT_SATURATION, VIBRANT_LIGHTNESS, gen);
+        }
+
+        static Palette vibrant(size_t count = 8) { return vibrant(count, rng::engine()); }
+
         // Export to hex strings
         std::vector<std::string> to_hex() const {
             std::vector<std::string> hex_colors;
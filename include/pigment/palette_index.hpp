@@ -0,0 +1,266 @@
+#pragma once
+
+#include "types_basic.hpp"
+#include "types_lab.hpp"
+#include "types_oklab.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace pigment {
+
+    /**
+     * @brief Prebuilt nearest-color index over a palette
+     *
+     * Palette entries are converted to LAB (or OKLAB) once and stored in a k-d tree, so a query costs one
+     * conversion and O(log P) distance evaluations instead of 2 * P conversions. With Space::LAB the result
+     * is the same entry utils::find_closest_color returns (CIE76 distance, ties resolved to the lowest index).
+     */
+    class PaletteIndex {
+      public:
+        enum class Space { LAB, OKLAB };
+
+      private:
+        using Point = std::array<double, 3>;
+
+        struct Node {
+            double split = 0.0;
+            uint32_t begin = 0; // leaf range into entries_
+            uint32_t end = 0;
+            uint32_t left = 0; // right child is left + 1
+            uint8_t axis = 0;
+            bool leaf = true;
+        };
+
+        static constexpr size_t LEAF_SIZE = 8;
+
+        struct Entry {
+            Point point;
+            uint32_t index; // position in the palette
+        };
+
+        Space space_ = Space::LAB;
+        std::vector<RGB> colors_;
+        std::vector<Entry> entries_; // tree order
+        std::vector<Node> nodes_;
+
+        Point to_point(const RGB &color) const {
+            if (space_ == Space::OKLAB) {
+                OKLAB c = OKLAB::fromRGB(color);
+                return {c.l(), c.a(), c.b()};
+            }
+            LAB c = LAB::fromRGB(color);
+            return {c.l(), c.a(), c.b()};
+        }
+
+        static double distance_sq(const Point &a, const Point &b) {
+            double d0 = a[0] - b[0];
+            double d1 = a[1] - b[1];
+            double d2 = a[2] - b[2];
+            return d0 * d0 + d1 * d1 + d2 * d2;
+        }
+
+        void build(uint32_t node, uint32_t begin, uint32_t end) {
+            nodes_[node].begin = begin;
+            nodes_[node].end = end;
+            if (end - begin <= LEAF_SIZE) {
+                return;
+            }
+
+            // Split along the axis with the widest spread
+            Point lo = entries_[begin].point, hi = entries_[begin].point;
+            for (uint32_t i = begin + 1; i < end; ++i) {
+                for (int c = 0; c < 3; ++c) {
+                    lo[c] = std::min(lo[c], entries_[i].point[c]);
+                    hi[c] = std::max(hi[c], entries_[i].point[c]);
+                }
+            }
+            uint8_t axis = 0;
+            for (uint8_t c = 1; c < 3; ++c) {
+                if (hi[c] - lo[c] > hi[axis] - lo[axis]) {
+                    axis = c;
+                }
+            }
+
+            uint32_t mid = begin + (end - begin) / 2;
+            std::nth_element(entries_.begin() + begin, entries_.begin() + mid, entries_.begin() + end,
+                             [axis](const Entry &a, const Entry &b) { return a.point[axis] < b.point[axis]; });
+
+            uint32_t left = static_cast<uint32_t>(nodes_.size());
+            nodes_.resize(nodes_.size() + 2);
+            nodes_[node].leaf = false;
+            nodes_[node].axis = axis;
+            nodes_[node].split = entries_[mid].point[axis];
+            nodes_[node].left = left;
+            build(left, begin, mid);
+            build(left + 1, mid, end);
+        }
+
+        // Better candidate: closer, or equally close with a lower palette index
+        static bool better(double dist, uint32_t index, double best_dist, uint32_t best_index) {
+            return dist < best_dist || (dist == best_dist && index < best_index);
+        }
+
+        void search(uint32_t node_id, const Point &q, double &best_dist, uint32_t &best_index) const {
+            const Node &node = nodes_[node_id];
+            if (node.leaf) {
+                for (uint32_t i = node.begin; i < node.end; ++i) {
+                    double d = distance_sq(q, entries_[i].point);
+                    if (better(d, entries_[i].index, best_dist, best_index)) {
+                        best_dist = d;
+                        best_index = entries_[i].index;
+                    }
+                }
+                return;
+            }
+            double diff = q[node.axis] - node.split;
+            uint32_t near = diff < 0.0 ? node.left : node.left + 1;
+            search(near, q, best_dist, best_index);
+            // <= so equally distant entries with a lower index on the far side are still found
+            if (diff * diff <= best_dist) {
+                search(near == node.left ? node.left + 1 : node.left, q, best_dist, best_index);
+            }
+        }
+
+        void search_k(uint32_t node_id, const Point &q, size_t k,
+                      std::vector<std::pair<double, uint32_t>> &heap) const {
+            const Node &node = nodes_[node_id];
+            if (node.leaf) {
+                for (uint32_t i = node.begin; i < node.end; ++i) {
+                    std::pair<double, uint32_t> candidate{distance_sq(q, entries_[i].point), entries_[i].index};
+                    if (heap.size() < k) {
+                        heap.push_back(candidate);
+                        std::push_heap(heap.begin(), heap.end());
+                    } else if (candidate < heap.front()) {
+                        std::pop_heap(heap.begin(), heap.end());
+                        heap.back() = candidate;
+                        std::push_heap(heap.begin(), heap.end());
+                    }
+                }
+                return;
+            }
+            double diff = q[node.axis] - node.split;
+            uint32_t near = diff < 0.0 ? node.left : node.left + 1;
+            search_k(near, q, k, heap);
+            if (heap.size() < k || diff * diff <= heap.front().first) {
+                search_k(near == node.left ? node.left + 1 : node.left, q, k, heap);
+            }
+        }
+
+        uint32_t nearest_point(const Point &q) const {
+            double best_dist = std::numeric_limits<double>::infinity();
+            uint32_t best_index = std::numeric_limits<uint32_t>::max();
+            search(0, q, best_dist, best_index);
+            return best_index;
+        }
+
+      public:
+        PaletteIndex() = default;
+
+        explicit PaletteIndex(std::span<const RGB> palette, Space space = Space::LAB)
+            : space_(space), colors_(palette.begin(), palette.end()) {
+            PIGMENT_SCOPE_N("PaletteIndex::build", palette.size());
+            if (colors_.size() > std::numeric_limits<uint32_t>::max()) {
+                throw std::invalid_argument("Palette is too large to index");
+            }
+            entries_.reserve(colors_.size());
+            for (uint32_t i = 0; i < colors_.size(); ++i) {
+                entries_.push_back({to_point(colors_[i]), i});
+            }
+            if (!colors_.empty()) {
+                nodes_.resize(1);
+                build(0, 0, static_cast<uint32_t>(colors_.size()));
+            }
+        }
+
+        explicit PaletteIndex(const std::vector<RGB> &palette, Space space = Space::LAB)
+            : PaletteIndex(std::span<const RGB>(palette), space) {}
+
+        size_t size() const { return colors_.size(); }
+        bool empty() const { return colors_.empty(); }
+        Space space() const { return space_; }
+        const std::vector<RGB> &colors() const { return colors_; }
+
+        // Index of the palette entry closest to `color`; throws on an empty palette
+        size_t nearest(const RGB &color) const {
+            if (empty()) {
+                throw std::invalid_argument("Cannot query an empty palette");
+            }
+            return nearest_point(to_point(color));
+        }
+
+        // Closest palette entry itself
+        const RGB &nearest_color(const RGB &color) const { return colors_[nearest(color)]; }
+
+        // Indices of the k closest entries, closest first (fewer if the palette is smaller)
+        std::vector<size_t> k_nearest(const RGB &color, size_t k) const {
+            std::vector<size_t> result;
+            if (empty() || k == 0) {
+                return result;
+            }
+            std::vector<std::pair<double, uint32_t>> heap;
+            heap.reserve(k);
+            search_k(0, to_point(color), k, heap);
+            std::sort(heap.begin(), heap.end());
+            result.reserve(heap.size());
+            for (const auto &entry : heap) {
+                result.push_back(entry.second);
+            }
+            return result;
+        }
+
+        // Batch query: palette index per input color. Runs of identical colors reuse the previous answer.
+        void nearest(std::span<const RGB> colors, std::span<uint32_t> out) const {
+            if (out.size() < colors.size()) {
+                throw std::invalid_argument("Destination span is smaller than source span");
+            }
+            if (colors.empty()) {
+                return;
+            }
+            if (empty()) {
+                throw std::invalid_argument("Cannot query an empty palette");
+            }
+            RGB previous = colors[0];
+            uint32_t answer = nearest_point(to_point(previous));
+            for (size_t i = 0; i < colors.size(); ++i) {
+                const RGB &c = colors[i];
+                if (c.r() != previous.r() || c.g() != previous.g() || c.b() != previous.b()) {
+                    previous = c;
+                    answer = nearest_point(to_point(c));
+                }
+                out[i] = answer;
+            }
+        }
+
+        // Batch quantization: replace every color by its closest palette entry
+        void quantize(std::span<const RGB> colors, std::span<RGB> out) const {
+            PIGMENT_SCOPE_N("PaletteIndex::quantize", colors.size());
+            if (out.size() < colors.size()) {
+                throw std::invalid_argument("Destination span is smaller than source span");
+            }
+            if (colors.empty()) {
+                return;
+            }
+            if (empty()) {
+                throw std::invalid_argument("Cannot query an empty palette");
+            }
+            RGB previous = colors[0];
+            uint32_t answer = nearest_point(to_point(previous));
+            for (size_t i = 0; i < colors.size(); ++i) {
+                const RGB c = colors[i];
+                if (c.r() != previous.r() || c.g() != previous.g() || c.b() != previous.b()) {
+                    previous = c;
+                    answer = nearest_point(to_point(c));
+                }
+                out[i] = colors_[answer];
+            }
+        }
+    };
+
+} // namespace pigment
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace pigment {
+    namespace parallel {
+
+        // Executors run `fn(i)` for every i in [0, count); any callable with this shape can be passed where a
+        // pigment function takes an executor (e.g. a wrapper around std::for_each(std::execution::par, ...)).
+
+        // Runs every task on the calling thread
+        struct SerialExecutor {
+            template <typename Fn> void operator()(size_t count, Fn &&fn) const {
+                for (size_t i = 0; i < count; ++i) {
+                    fn(i);
+                }
+            }
+        };
+
+        // Spawns up to `threads` workers (0 = hardware concurrency) that pull task indices from a shared counter,
+        // so faster threads take over the remaining tiles. The first exception thrown by a task is rethrown.
+        class ThreadExecutor {
+          private:
+            size_t threads_;
+
+          public:
+            explicit ThreadExecutor(size_t threads = 0)
+                : threads_(threads ? threads : std::max(1u, std::thread::hardware_concurrency())) {}
+
+            size_t threads() const { return threads_; }
+
+            template <typename Fn> void operator()(size_t count, Fn &&fn) const {
+                const size_t workers = std::min(threads_, count);
+                if (workers <= 1) {
+                    SerialExecutor{}(count, fn);
+                    return;
+                }
+
+                std::atomic<size_t> next{0};
+                std::exception_ptr error;
+                std::mutex error_mutex;
+                auto worker = [&] {
+                    for (size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < count;) {
+                        try {
+                            fn(i);
+                        } catch (...) {
+                            std::lock_guard<std::mutex> lock(error_mutex);
+                            if (!error) {
+                                error = std::current_exception();
+                            }
+                            next.store(count, std::memory_order_relaxed);
+                        }
+                    }
+                };
+
+                std::vector<std::thread> pool;
+                pool.reserve(workers - 1);
+                for (size_t t = 1; t < workers; ++t) {
+                    pool.emplace_back(worker);
+                }
+                worker();
+                for (auto &thread : pool) {
+                    thread.join();
+                }
+                if (error) {
+                    std::rethrow_exception(error);
+                }
+            }
+        };
+
+        // Default tile: 16K pixels, i.e. 64 KB of RGB input plus as much output, sized to stay in L2
+        constexpr size_t DEFAULT_TILE_SIZE = 16384;
+
+        // Split [0, n) into tiles and run `fn(begin, end)` for each on `executor`
+        template <typename Executor, typename Fn>
+        void for_each_tile(size_t n, Executor &&executor, Fn &&fn, size_t tile_size = DEFAULT_TILE_SIZE) {
+            tile_size = std::max<size_t>(tile_size, 1);
+            const size_t tiles = (n + tile_size - 1) / tile_size;
+            executor(tiles, [&](size_t tile) {
+                const size_t begin = tile * tile_size;
+                fn(begin, std::min(begin + tile_size, n));
+            });
+        }
+
+    } // namespace parallel
+} // namespace pigment
@@ -1,7 +1,31 @@
 #pragma once
 
+#include "blend.hpp"
+#include "color_traits.hpp"
+#include "color_vision.hpp"
+#include "colormap.hpp"
+#include "contrast.hpp"
+#include "conversion_cache.hpp"
+#include "convert.hpp"
+#include "delta_e.hpp"
+#include "dither.hpp"
+#include "dominant.hpp"
+#include "histogram.hpp"
+#include "instrumentation.hpp"
+#include "lut3d.hpp"
+#include "mapped_file.hpp"
 #include "palette.hpp"
+#include "palette_index.hpp"
+#include "parallel.hpp"
+#include "planar.hpp"
+#include "premultiplied.hpp"
+#include "random.hpp"
+#include "rgba32.hpp"
+#include "serialization.hpp"
+#include "simd.hpp"
+#include "transform.hpp"
 #include "types_basic.hpp"
+#include "types_float.hpp"
 #include "types_hsl.hpp"
 #include "types_hsv.hpp"
 #include "types_lab.hpp"
@@ -0,0 +1,209 @@
+#pragma once
+
+#include "color_traits.hpp"
+#include "convert.hpp"
+#include "simd.hpp"
+
+#include <cstddef>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace pigment {
+
+    // Allocator returning storage aligned to `Alignment` bytes (one cache line by default)
+    template <typename T, size_t Alignment = 64> struct AlignedAllocator {
+        using value_type = T;
+        template <typename U> struct rebind {
+            using other = AlignedAllocator<U, Alignment>;
+        };
+
+        AlignedAllocator() = default;
+        template <typename U> AlignedAllocator(const AlignedAllocator<U, Alignment> &) noexcept {}
+
+        T *allocate(size_t n) { return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t{Alignment})); }
+        void deallocate(T *p, size_t) noexcept { ::operator delete(p, std::align_val_t{Alignment}); }
+
+        template <typename U> bool operator==(const AlignedAllocator<U, Alignment> &) const noexcept { return true; }
+    };
+
+    /**
+     * @brief Structure-of-arrays image with one plane per channel
+     *
+     * Channels follow color_traits<T> (RGB has r, g, b, a planes; LABf has l, a, b, alpha planes, ...).
+     * Every row starts on a 64-byte boundary, so stride() can be larger than width(). Works with every
+     * color type stored as a datapod vector: RGB, MONO, HSV, LAB, LCH, XYZ, OKLAB and the float variants.
+     */
+    template <typename T> class PlanarImage {
+      public:
+        using traits = color_traits<T>;
+        using channel_type = typename traits::channel_type;
+        static constexpr size_t channels = traits::channels;
+        static constexpr size_t ALIGNMENT = 64;
+
+      private:
+        size_t width_ = 0;
+        size_t height_ = 0;
+        size_t stride_ = 0;
+        std::vector<channel_type, AlignedAllocator<channel_type, ALIGNMENT>> data_;
+
+        static size_t aligned_stride(size_t width) {
+            constexpr size_t per_line = ALIGNMENT / sizeof(channel_type);
+            return (width + per_line - 1) / per_line * per_line;
+        }
+
+        size_t plane_size() const { return stride_ * height_; }
+
+      public:
+        PlanarImage() = default;
+        PlanarImage(size_t width, size_t height) { resize(width, height); }
+
+        // Resize the image; all channels are reset to zero
+        void resize(size_t width, size_t height) {
+            width_ = width;
+            height_ = height;
+            stride_ = aligned_stride(width);
+            data_.assign(plane_size() * channels, channel_type{});
+        }
+
+        size_t width() const { return width_; }
+        size_t height() const { return height_; }
+        size_t stride() const { return stride_; }
+        size_t size() const { return width_ * height_; }
+        bool empty() const { return size() == 0; }
+
+        // Raw plane access (stride() elements per row)
+        channel_type *plane(size_t channel) { return data_.data() + channel * plane_size(); }
+        const channel_type *plane(size_t channel) const { return data_.data() + channel * plane_size(); }
+
+        // Row view of one channel, padding excluded
+        std::span<channel_type> row(size_t channel, size_t y) { return {plane(channel) + y * stride_, width_}; }
+        std::span<const channel_type> row(size_t channel, size_t y) const {
+            return {plane(channel) + y * stride_, width_};
+        }
+
+        // Gather a single pixel
+        T at(size_t x, size_t y) const {
+            T out;
+            channel_type *dst = traits::data(out);
+            const size_t offset = y * stride_ + x;
+            for (size_t c = 0; c < channels; ++c) {
+                dst[c] = plane(c)[offset];
+            }
+            return out;
+        }
+
+        // Scatter a single pixel
+        void set(size_t x, size_t y, const T &color) {
+            const channel_type *src = traits::data(color);
+            const size_t offset = y * stride_ + x;
+            for (size_t c = 0; c < channels; ++c) {
+                plane(c)[offset] = src[c];
+            }
+        }
+
+        // Deinterleave a row-major buffer of width() * height() pixels into the existing planes
+        void load(std::span<const T> pixels) {
+            if (pixels.size() < size()) {
+                throw std::invalid_argument("Pixel buffer is smaller than width * height");
+            }
+            for (size_t y = 0; y < height_; ++y) {
+                const T *src = pixels.data() + y * width_;
+                for (size_t c = 0; c < channels; ++c) {
+                    channel_type *dst = plane(c) + y * stride_;
+                    for (size_t x = 0; x < width_; ++x) {
+                        dst[x] = traits::data(src[x])[c];
+                    }
+                }
+            }
+        }
+
+        // Interleave into a row-major buffer of at least width() * height() pixels
+        void to_interleaved(std::span<T> pixels) const {
+            if (pixels.size() < size()) {
+                throw std::invalid_argument("Pixel buffer is smaller than width * height");
+            }
+            for (size_t y = 0; y < height_; ++y) {
+                T *dst = pixels.data() + y * width_;
+                for (size_t c = 0; c < channels; ++c) {
+                    const channel_type *src = plane(c) + y * stride_;
+                    for (size_t x = 0; x < width_; ++x) {
+                        traits::data(dst[x])[c] = src[x];
+                    }
+                }
+            }
+        }
+
+        std::vector<T> to_interleaved() const {
+            std::vector<T> pixels(size());
+            to_interleaved(std::span<T>(pixels));
+            return pixels;
+        }
+
+        static PlanarImage from_interleaved(std::span<const T> pixels, size_t width, size_t height) {
+            PlanarImage image(width, height);
+            image.load(pixels);
+            return image;
+        }
+    };
+
+    namespace planar_detail {
+
+        // Float kernel space used for RGB planes -> T planes, void when T has no vector kernel
+        template <typename T> struct kernel_space {
+            using type = void;
+        };
+        template <> struct kernel_space<LAB> {
+            using type = simd::LabSpace;
+        };
+        template <> struct kernel_space<LABf> {
+            using type = simd::LabSpace;
+        };
+        template <> struct kernel_space<OKLAB> {
+            using type = simd::OklabSpace;
+        };
+        template <> struct kernel_space<OKLABf> {
+            using type = simd::OklabSpace;
+        };
+        template <> struct kernel_space<XYZ> {
+            using type = simd::XyzSpace;
+        };
+        template <> struct kernel_space<XYZf> {
+            using type = simd::XyzSpace;
+        };
+
+    } // namespace planar_detail
+
+    // Plane-to-plane conversion; `dst` is resized to the source dimensions when they differ.
+    // RGB -> LAB / OKLAB / XYZ (double or float) reads the planes straight into the vector kernels.
+    template <typename From, typename To> inline void convert(const PlanarImage<From> &src, PlanarImage<To> &dst) {
+        if (dst.width() != src.width() || dst.height() != src.height()) {
+            dst.resize(src.width(), src.height());
+        }
+
+        using Space = typename planar_detail::kernel_space<To>::type;
+        if constexpr (std::is_same_v<From, RGB> && !std::is_void_v<Space>) {
+            for (size_t y = 0; y < src.height(); ++y) {
+                simd::planes_to_space<Space>(src.row(0, y).data(), src.row(1, y).data(), src.row(2, y).data(),
+                                             dst.row(0, y).data(), dst.row(1, y).data(), dst.row(2, y).data(),
+                                             src.width());
+                if constexpr (Space::has_alpha) {
+                    auto alpha_in = src.row(3, y);
+                    auto alpha_out = dst.row(3, y);
+                    for (size_t x = 0; x < src.width(); ++x) {
+                        alpha_out[x] = static_cast<typename PlanarImage<To>::channel_type>(alpha_in[x]);
+                    }
+                }
+            }
+        } else {
+            for (size_t y = 0; y < src.height(); ++y) {
+                for (size_t x = 0; x < src.width(); ++x) {
+                    dst.set(x, y, batch_detail::convert_one<From, To>(src.at(x, y)));
+                }
+            }
+        }
+    }
+
+} // namespace pigment
@@ -0,0 +1,383 @@
+#pragma once
+
+#include "blend.hpp"
+#include "types_basic.hpp"
+#include "types_lab.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace pigment {
+
+    /**
+     * @brief 8-bit RGBA with color channels premultiplied by alpha, built on datapod::mat::Vector<uint8_t, 4>
+     *
+     * Same layout as RGB. Compositing premultiplied pixels needs only multiplies by alpha, so a layer stack can be
+     * kept in this form and converted back to straight alpha once at the end.
+     */
+    struct PremulRGBA : public dp::mat::Vector<uint8_t, 4> {
+        using base_type = dp::mat::Vector<uint8_t, 4>;
+
+        // Accessors for color components
+        uint8_t &r() { return data_[0]; }
+        uint8_t &g() { return data_[1]; }
+        uint8_t &b() { return data_[2]; }
+        uint8_t &a() { return data_[3]; }
+
+        const uint8_t &r() const { return data_[0]; }
+        const uint8_t &g() const { return data_[1]; }
+        const uint8_t &b() const { return data_[2]; }
+        const uint8_t &a() const { return data_[3]; }
+
+        PremulRGBA() {
+            data_[0] = 0;
+            data_[1] = 0;
+            data_[2] = 0;
+            data_[3] = 0;
+        }
+
+        // Channels are taken as already premultiplied
+        PremulRGBA(uint8_t r_, uint8_t g_, uint8_t b_, uint8_t a_) {
+            data_[0] = r_;
+            data_[1] = g_;
+            data_[2] = b_;
+            data_[3] = a_;
+        }
+
+        static PremulRGBA fromRGB(const RGB &rgb) {
+            const uint32_t alpha = rgb.a();
+            return PremulRGBA(static_cast<uint8_t>(blend_detail::div255_round(rgb.r() * alpha)),
+                              static_cast<uint8_t>(blend_detail::div255_round(rgb.g() * alpha)),
+                              static_cast<uint8_t>(blend_detail::div255_round(rgb.b() * alpha)), rgb.a());
+        }
+
+        // Back to straight alpha; the division by alpha is a table reciprocal multiply
+        RGB to_rgb() const {
+            const uint32_t alpha = a();
+            if (alpha == 0) {
+                return RGB(0, 0, 0, 0);
+            }
+            const uint64_t recip = blend_detail::reciprocal_table()[alpha];
+            auto channel = [&](uint32_t c) {
+                uint32_t v = static_cast<uint32_t>(((c * 255 + alpha / 2) * recip) >> 24);
+                return static_cast<uint8_t>(v > 255 ? 255 : v);
+            };
+            return RGB(channel(r()), channel(g()), channel(b()), a());
+        }
+
+        bool operator==(const PremulRGBA &other) const {
+            return r() == other.r() && g() == other.g() && b() == other.b() && a() == other.a();
+        }
+        bool operator!=(const PremulRGBA &other) const { return !(*this == other); }
+    };
+
+    /**
+     * @brief Linear-light, premultiplied RGBA in single precision, built on datapod::mat::Vector<float, 4>
+     *
+     * Channels are in [0, 1]. Decoding goes through lab_tables::gamma_to_linear, so blending, filtering and
+     * averaging in this form are physically correct instead of mixing gamma-encoded values.
+     */
+    struct LinearRGBA : public dp::mat::Vector<float, 4> {
+        using base_type = dp::mat::Vector<float, 4>;
+
+        // Accessors for color components
+        float &r() { return data_[0]; }
+        float &g() { return data_[1]; }
+        float &b() { return data_[2]; }
+        float &a() { return data_[3]; }
+
+        const float &r() const { return data_[0]; }
+        const float &g() const { return data_[1]; }
+        const float &b() const { return data_[2]; }
+        const float &a() const { return data_[3]; }
+
+        LinearRGBA() {
+            data_[0] = 0.0f;
+            data_[1] = 0.0f;
+            data_[2] = 0.0f;
+            data_[3] = 0.0f;
+        }
+
+        // Channels are taken as linear and already premultiplied
+        LinearRGBA(float r_, float g_, float b_, float a_ = 1.0f) {
+            data_[0] = r_;
+            data_[1] = g_;
+            data_[2] = b_;
+            data_[3] = a_;
+        }
+
+        static LinearRGBA fromRGB(const RGB &rgb) {
+            const float alpha = rgb.a() * (1.0f / 255.0f);
+            return LinearRGBA(lab_tables::gamma_to_linear_f[rgb.r()] * alpha,
+                              lab_tables::gamma_to_linear_f[rgb.g()] * alpha,
+                              lab_tables::gamma_to_linear_f[rgb.b()] * alpha, alpha);
+        }
+
+        static LinearRGBA fromPremul(const PremulRGBA &p) { return fromRGB(p.to_rgb()); }
+
+        inline RGB to_rgb() const;
+
+        PremulRGBA to_premul() const { return PremulRGBA::fromRGB(to_rgb()); }
+    };
+
+    namespace premul_detail {
+
+        // round(255 * encode(i / 4095)); every 8-bit code round-trips through its linear value
+        inline const std::array<uint8_t, lab_tables::LINEAR_TABLE_SIZE> &linear_to_byte_table() {
+            static const auto table = [] {
+                std::array<uint8_t, lab_tables::LINEAR_TABLE_SIZE> t{};
+                for (size_t i = 0; i < t.size(); ++i) {
+                    double v = lab_tables::exact_linear_to_gamma(i / double(t.size() - 1));
+                    t[i] = static_cast<uint8_t>(std::clamp(std::lround(v * 255.0), 0L, 255L));
+                }
+                return t;
+            }();
+            return table;
+        }
+
+        inline uint8_t linear_to_byte(float v) {
+            constexpr float scale = static_cast<float>(lab_tables::LINEAR_TABLE_SIZE - 1);
+            v = std::clamp(v, 0.0f, 1.0f);
+            return linear_to_byte_table()[static_cast<size_t>(v * scale + 0.5f)];
+        }
+
+    } // namespace premul_detail
+
+    inline RGB LinearRGBA::to_rgb() const {
+        if (a() <= 0.0f) {
+            return RGB(0, 0, 0, 0);
+        }
+        const float inv = 1.0f / a();
+        return RGB(premul_detail::linear_to_byte(r() * inv), premul_detail::linear_to_byte(g() * inv),
+                   premul_detail::linear_to_byte(b() * inv),
+                   static_cast<uint8_t>(std::clamp(std::lround(a() * 255.0f), 0L, 255L)));
+    }
+
+    /**
+     * @brief Porter-Duff compositing operators
+     *
+     * Each operator is result = src * Fa + dst * Fb on premultiplied values, with Fa and Fb drawn from
+     * {0, 1, alpha_src, 1 - alpha_src, alpha_dst, 1 - alpha_dst}; PLUS saturates.
+     */
+    enum class PorterDuff {
+        CLEAR,
+        SRC,
+        DST,
+        SRC_OVER,
+        DST_OVER,
+        SRC_IN,
+        DST_IN,
+        SRC_OUT,
+        DST_OUT,
+        SRC_ATOP,
+        DST_ATOP,
+        XOR,
+        PLUS
+    };
+
+    namespace premul_detail {
+
+        // (Fa, Fb) for operator Op; `one` is 255 for 8-bit and 1 for float channels
+        template <PorterDuff Op, typename T> inline std::pair<T, T> factors(T as, T ad, T one) {
+            if constexpr (Op == PorterDuff::CLEAR) {
+                return {0, 0};
+            } else if constexpr (Op == PorterDuff::SRC) {
+                return {one, 0};
+            } else if constexpr (Op == PorterDuff::DST) {
+                return {0, one};
+            } else if constexpr (Op == PorterDuff::SRC_OVER) {
+                return {one, one - as};
+            } else if constexpr (Op == PorterDuff::DST_OVER) {
+                return {one - ad, one};
+            } else if constexpr (Op == PorterDuff::SRC_IN) {
+                return {ad, 0};
+            } else if constexpr (Op == PorterDuff::DST_IN) {
+                return {0, as};
+            } else if constexpr (Op == PorterDuff::SRC_OUT) {
+                return {one - ad, 0};
+            } else if constexpr (Op == PorterDuff::DST_OUT) {
+                return {0, one - as};
+            } else if constexpr (Op == PorterDuff::SRC_ATOP) {
+                return {ad, one - as};
+            } else if constexpr (Op == PorterDuff::DST_ATOP) {
+                return {one - ad, as};
+            } else if constexpr (Op == PorterDuff::XOR) {
+                return {one - ad, one - as};
+            } else {
+                return {one, one};
+            }
+        }
+
+        template <PorterDuff Op> inline PremulRGBA composite(const PremulRGBA &s, const PremulRGBA &d) {
+            const auto [fa, fb] = factors<Op, uint32_t>(s.a(), d.a(), 255);
+            auto channel = [fa, fb](uint32_t sc, uint32_t dc) {
+                uint32_t v;
+                if constexpr (Op == PorterDuff::PLUS) {
+                    v = sc + dc;
+                } else {
+                    // Terms are rounded separately so the sum never leaves the exact range of div255_round
+                    v = blend_detail::div255_round(sc * fa) + blend_detail::div255_round(dc * fb);
+                }
+                return static_cast<uint8_t>(v > 255 ? 255 : v);
+            };
+            // Built from four values at once: writing channels one by one through memory stalls store forwarding
+            return PremulRGBA(channel(s.r(), d.r()), channel(s.g(), d.g()), channel(s.b(), d.b()),
+                              channel(s.a(), d.a()));
+        }
+
+        template <PorterDuff Op> inline LinearRGBA composite(const LinearRGBA &s, const LinearRGBA &d) {
+            const auto [fa, fb] = factors<Op, float>(s.a(), d.a(), 1.0f);
+            LinearRGBA out;
+            for (size_t c = 0; c < 4; ++c) {
+                float v = s.data_[c] * fa + d.data_[c] * fb;
+                out.data_[c] = Op == PorterDuff::PLUS ? std::min(v, 1.0f) : v;
+            }
+            return out;
+        }
+
+#ifdef PIGMENT_SIMD_AVX2
+        // composite<Op> on 4 pixels widened to 16-bit lanes
+        template <PorterDuff Op> inline __m256i composite16(__m256i d, __m256i s) {
+            using namespace blend_detail;
+            const __m256i one = _mm256_set1_epi16(255);
+            const __m256i zero = _mm256_setzero_si256();
+            const __m256i as = broadcast_alpha16(s), ad = broadcast_alpha16(d);
+            __m256i fa = zero, fb = zero;
+            if constexpr (Op == PorterDuff::SRC || Op == PorterDuff::SRC_OVER) {
+                fa = one;
+            } else if constexpr (Op == PorterDuff::SRC_IN || Op == PorterDuff::SRC_ATOP) {
+                fa = ad;
+            } else if constexpr (Op == PorterDuff::DST_OVER || Op == PorterDuff::SRC_OUT ||
+                                 Op == PorterDuff::DST_ATOP || Op == PorterDuff::XOR) {
+                fa = _mm256_sub_epi16(one, ad);
+            }
+            if constexpr (Op == PorterDuff::DST || Op == PorterDuff::DST_OVER) {
+                fb = one;
+            } else if constexpr (Op == PorterDuff::DST_IN || Op == PorterDuff::DST_ATOP) {
+                fb = as;
+            } else if constexpr (Op == PorterDuff::SRC_OVER || Op == PorterDuff::DST_OUT ||
+                                 Op == PorterDuff::SRC_ATOP || Op == PorterDuff::XOR) {
+                fb = _mm256_sub_epi16(one, as);
+            }
+            __m256i v = _mm256_add_epi16(div255_round16(_mm256_mullo_epi16(s, fa)),
+                                         div255_round16(_mm256_mullo_epi16(d, fb)));
+            return _mm256_min_epu16(v, one);
+        }
+#endif
+
+        template <PorterDuff Op, typename T> inline void composite_span(const T *src, T *dst, size_t n) {
+            size_t i = 0;
+            if constexpr (std::is_same_v<T, PremulRGBA> && sizeof(PremulRGBA) == 4) {
+                if constexpr (Op == PorterDuff::SRC_OVER || Op == PorterDuff::PLUS) {
+                    // Shared with blend_premultiplied(), which vectorizes both
+                    constexpr BlendMode mode = Op == PorterDuff::SRC_OVER ? BlendMode::NORMAL : BlendMode::ADD;
+                    blend_detail::blend_span_premultiplied<mode>(&src->r(), &dst->r(), n);
+                    return;
+                }
+#ifdef PIGMENT_SIMD_AVX2
+                for (; i + 8 <= n; i += 8) {
+                    blend_detail::widen_apply(&src[i].r(), &dst[i].r(),
+                                              [](__m256i dv, __m256i sv) { return composite16<Op>(dv, sv); });
+                }
+#endif
+            }
+            for (; i < n; ++i) {
+                dst[i] = composite<Op>(src[i], dst[i]);
+            }
+        }
+
+        template <typename T> inline void dispatch(PorterDuff op, const T *src, T *dst, size_t n) {
+            switch (op) {
+            case PorterDuff::CLEAR:
+                return composite_span<PorterDuff::CLEAR>(src, dst, n);
+            case PorterDuff::SRC:
+                return composite_span<PorterDuff::SRC>(src, dst, n);
+            case PorterDuff::DST:
+                return composite_span<PorterDuff::DST>(src, dst, n);
+            case PorterDuff::SRC_OVER:
+                return composite_span<PorterDuff::SRC_OVER>(src, dst, n);
+            case PorterDuff::DST_OVER:
+                return composite_span<PorterDuff::DST_OVER>(src, dst, n);
+            case PorterDuff::SRC_IN:
+                return composite_span<PorterDuff::SRC_IN>(src, dst, n);
+            case PorterDuff::DST_IN:
+                return composite_span<PorterDuff::DST_IN>(src, dst, n);
+            case PorterDuff::SRC_OUT:
+                return composite_span<PorterDuff::SRC_OUT>(src, dst, n);
+            case PorterDuff::DST_OUT:
+                return composite_span<PorterDuff::DST_OUT>(src, dst, n);
+            case PorterDuff::SRC_ATOP:
+                return composite_span<PorterDuff::SRC_ATOP>(src, dst, n);
+            case PorterDuff::DST_ATOP:
+                return composite_span<PorterDuff::DST_ATOP>(src, dst, n);
+            case PorterDuff::XOR:
+                return composite_span<PorterDuff::XOR>(src, dst, n);
+            case PorterDuff::PLUS:
+                return composite_span<PorterDuff::PLUS>(src, dst, n);
+            }
+        }
+
+        template <typename In, typename Out, typename Fn>
+        inline void convert_span(std::span<In> src, std::span<Out> dst, Fn fn) {
+            if (dst.size() < src.size()) {
+                throw std::invalid_argument("Destination span is smaller than source span");
+            }
+            for (size_t i = 0; i < src.size(); ++i) {
+                dst[i] = fn(src[i]);
+            }
+        }
+
+    } // namespace premul_detail
+
+    // Composite one premultiplied pixel: returns `src op dst`
+    inline PremulRGBA composite(PorterDuff op, const PremulRGBA &src, const PremulRGBA &dst) {
+        PremulRGBA out = dst;
+        premul_detail::dispatch(op, &src, &out, 1);
+        return out;
+    }
+
+    inline LinearRGBA composite(PorterDuff op, const LinearRGBA &src, const LinearRGBA &dst) {
+        LinearRGBA out = dst;
+        premul_detail::dispatch(op, &src, &out, 1);
+        return out;
+    }
+
+    // Composite src onto dst in place; dst must hold at least src.size() pixels
+    inline void composite(PorterDuff op, std::span<const PremulRGBA> src, std::span<PremulRGBA> dst) {
+        if (dst.size() < src.size()) {
+            throw std::invalid_argument("Destination span is smaller than source span");
+        }
+        premul_detail::dispatch(op, src.data(), dst.data(), src.size());
+    }
+
+    inline void composite(PorterDuff op, std::span<const LinearRGBA> src, std::span<LinearRGBA> dst) {
+        if (dst.size() < src.size()) {
+            throw std::invalid_argument("Destination span is smaller than source span");
+        }
+        premul_detail::dispatch(op, src.data(), dst.data(), src.size());
+    }
+
+    // Batch conversions in and out of the premultiplied forms
+    inline void premultiply(std::span<const RGB> src, std::span<PremulRGBA> dst) {
+        premul_detail::convert_span(src, dst, [](const RGB &c) { return PremulRGBA::fromRGB(c); });
+    }
+
+    inline void unpremultiply(std::span<const PremulRGBA> src, std::span<RGB> dst) {
+        premul_detail::convert_span(src, dst, [](const PremulRGBA &c) { return c.to_rgb(); });
+    }
+
+    inline void to_linear(std::span<const RGB> src, std::span<LinearRGBA> dst) {
+        premul_detail::convert_span(src, dst, [](const RGB &c) { return LinearRGBA::fromRGB(c); });
+    }
+
+    inline void from_linear(std::span<const LinearRGBA> src, std::span<RGB> dst) {
+        premul_detail::convert_span(src, dst, [](const LinearRGBA &c) { return c.to_rgb(); });
+    }
+
+} // namespace pigment
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+#include <random>
+
+namespace pigment {
+    namespace rng {
+
+        // Default generator behind every `random()` / `pastel()` / `vibrant()` that is not given one
+        using Engine = std::mt19937;
+
+        // One engine per thread, seeded from std::random_device on first use, so concurrent callers never share
+        // generator state. Functions that draw random colors also take any UniformRandomBitGenerator by reference
+        // when the caller wants its own (seeded, cheaper, or shared under its own lock).
+        inline Engine &engine() {
+            thread_local Engine engine(std::random_device{}());
+            return engine;
+        }
+
+        // Reseed the calling thread's engine, e.g. for reproducible output in tests
+        inline void seed(uint32_t value) { engine().seed(value); }
+
+    } // namespace rng
+} // namespace pigment
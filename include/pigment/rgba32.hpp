@@ -0,0 +1,153 @@
+#pragma once
+
+#include "types_basic.hpp"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+namespace pigment {
+
+    /**
+     * @brief RGBA packed into one uint32_t
+     *
+     * Red sits in the low byte and alpha in the high byte, which on little-endian targets is exactly the byte order
+     * of RGB, so converting either way is a 4-byte copy. Equality is a single integer compare and the channel-wise
+     * operations below are SWAR (all four bytes at once in a general-purpose register). Use it as a hash-map key or
+     * for bulk work where RGB's per-channel accessors get in the way.
+     */
+    struct RGBA32 {
+        uint32_t value = 0xFF000000u; // opaque black, same as RGB()
+
+        static constexpr uint32_t RGB_MASK = 0x00FFFFFFu;
+
+        // True when an RGB object already holds the bytes of the matching RGBA32
+        static constexpr bool SAME_LAYOUT = std::endian::native == std::endian::little && sizeof(RGB) == 4 &&
+                                            std::is_trivially_copyable_v<RGB>;
+
+      private:
+        static constexpr uint32_t HIGH_BITS = 0x80808080u;
+        static constexpr uint32_t LOW_BITS = 0x7F7F7F7Fu;
+
+        // 0xFF in every byte whose top bit is set in `bits`, 0 elsewhere (no carries cross bytes)
+        static constexpr uint32_t byte_mask(uint32_t bits) { return ((bits & HIGH_BITS) >> 7) * 0xFFu; }
+
+      public:
+        constexpr RGBA32() = default;
+        constexpr explicit RGBA32(uint32_t packed) : value(packed) {}
+        constexpr RGBA32(uint8_t r, uint8_t g, uint8_t b, uint8_t a = 255)
+            : value(static_cast<uint32_t>(r) | (static_cast<uint32_t>(g) << 8) | (static_cast<uint32_t>(b) << 16) |
+                    (static_cast<uint32_t>(a) << 24)) {}
+
+        explicit RGBA32(const RGB &color) {
+            if constexpr (SAME_LAYOUT) {
+                std::memcpy(&value, &color, sizeof(value));
+            } else {
+                *this = RGBA32(color.r(), color.g(), color.b(), color.a());
+            }
+        }
+
+        RGB to_rgb() const {
+            if constexpr (SAME_LAYOUT) {
+                RGB color;
+                std::memcpy(static_cast<void *>(&color), &value, sizeof(value));
+                return color;
+            } else {
+                return RGB(r(), g(), b(), a());
+            }
+        }
+
+        constexpr uint8_t r() const { return static_cast<uint8_t>(value); }
+        constexpr uint8_t g() const { return static_cast<uint8_t>(value >> 8); }
+        constexpr uint8_t b() const { return static_cast<uint8_t>(value >> 16); }
+        constexpr uint8_t a() const { return static_cast<uint8_t>(value >> 24); }
+
+        // 0xBBGGRR, i.e. the color with alpha ignored
+        constexpr uint32_t rgb() const { return value & RGB_MASK; }
+
+        constexpr bool operator==(const RGBA32 &other) const = default;
+
+        constexpr RGBA32 with_alpha(uint8_t alpha) const {
+            return RGBA32((value & RGB_MASK) | (static_cast<uint32_t>(alpha) << 24));
+        }
+
+        // Same as RGB::invert (alpha kept)
+        constexpr RGBA32 invert() const { return RGBA32(value ^ RGB_MASK); }
+
+        // Per-channel saturating add / subtract, same results as RGB::operator+ / operator-
+        constexpr RGBA32 operator+(const RGBA32 &other) const {
+            const uint32_t x = value, y = other.value;
+            const uint32_t sum = ((x & LOW_BITS) + (y & LOW_BITS)) ^ ((x ^ y) & HIGH_BITS);
+            const uint32_t carry = (x & y) | ((x | y) & ~sum);
+            return RGBA32(sum | byte_mask(carry));
+        }
+
+        constexpr RGBA32 operator-(const RGBA32 &other) const {
+            const uint32_t x = value, y = other.value;
+            const uint32_t diff = ((x | HIGH_BITS) - (y & LOW_BITS)) ^ ((x ^ ~y) & HIGH_BITS);
+            const uint32_t borrow = (~x & y) | (~(x ^ y) & diff);
+            return RGBA32(diff & ~byte_mask(borrow));
+        }
+
+        constexpr RGBA32 &operator+=(const RGBA32 &other) { return *this = *this + other; }
+        constexpr RGBA32 &operator-=(const RGBA32 &other) { return *this = *this - other; }
+    };
+
+    static_assert(sizeof(RGBA32) == 4 && std::is_trivially_copyable_v<RGBA32>);
+
+    // Bulk conversion; a single memcpy when RGB is already laid out as RGBA32
+    inline void pack(std::span<const RGB> src, std::span<RGBA32> dst) {
+        if (dst.size() < src.size()) {
+            throw std::invalid_argument("Destination span is smaller than source span");
+        }
+        if constexpr (RGBA32::SAME_LAYOUT) {
+            if (!src.empty()) {
+                std::memcpy(static_cast<void *>(dst.data()), src.data(), src.size_bytes());
+            }
+        } else {
+            for (size_t i = 0; i < src.size(); ++i) {
+                dst[i] = RGBA32(src[i]);
+            }
+        }
+    }
+
+    inline void unpack(std::span<const RGBA32> src, std::span<RGB> dst) {
+        if (dst.size() < src.size()) {
+            throw std::invalid_argument("Destination span is smaller than source span");
+        }
+        if constexpr (RGBA32::SAME_LAYOUT) {
+            if (!src.empty()) {
+                std::memcpy(static_cast<void *>(dst.data()), src.data(), src.size_bytes());
+            }
+        } else {
+            for (size_t i = 0; i < src.size(); ++i) {
+                dst[i] = src[i].to_rgb();
+            }
+        }
+    }
+
+} // namespace pigment
+
+// Hashing: a murmur3-style finalizer, so nearby colors spread over the buckets of power-of-two tables too
+template <> struct std::hash<pigment::RGBA32> {
+    size_t operator()(const pigment::RGBA32 &color) const noexcept {
+        uint32_t h = color.value;
+        h ^= h >> 16;
+        h *= 0x85EBCA6Bu;
+        h ^= h >> 13;
+        h *= 0xC2B2AE35u;
+        h ^= h >> 16;
+        return h;
+    }
+};
+
+template <> struct std::hash<pigment::RGB> {
+    size_t operator()(const pigment::RGB &color) const noexcept {
+        return std::hash<pigment::RGBA32>{}(pigment::RGBA32(color));
+    }
+};
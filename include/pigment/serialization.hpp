@@ -0,0 +1,490 @@
+#pragma once
+
+#include "color_traits.hpp"
+#include "mapped_file.hpp"
+#include "palette.hpp"
+#include "types_basic.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace pigment {
+    namespace serialization {
+
+        // Bulk format for color buffers: one fixed header, then the payload. Unlike dp::serialize there is no
+        // per-element framing, so INTERLEAVED and PLANAR payloads are plain memory and can be used in place.
+        //
+        //   INTERLEAVED  the colors exactly as they sit in memory (count * sizeof(T) bytes)
+        //   PLANAR       channel 0 of every color, then channel 1, ... (same size, handy for SoA consumers)
+        //   DELTA        planar, each channel stored as the byte difference to the previous color and then
+        //                run-length coded (PackBits). Gradients, sorted palettes and flat images shrink a lot;
+        //                decoding is sequential, so no view. 8-bit channel types only.
+        //
+        // Header fields are in host byte order, as in the ConversionCache file. The header records the element
+        // shape (size, channel count, channel size), not the color model, so reading RGB data as MONO fails but
+        // reading HSV data as XYZf (both three floats) does not.
+        enum class Layout : uint8_t { INTERLEAVED, PLANAR, DELTA };
+
+        struct Header {
+            char magic[4];
+            uint32_t version;
+            uint32_t element_size;
+            uint8_t channels;
+            uint8_t channel_size;
+            Layout layout;
+            uint8_t reserved;
+            uint64_t count;
+            uint64_t payload_size;
+        };
+        // 32 bytes, so a payload read from a page-aligned mapping stays aligned for every color type
+        static_assert(sizeof(Header) == 32);
+
+        inline constexpr char MAGIC[4] = {'P', 'G', 'M', 'B'};
+        inline constexpr uint32_t VERSION = 1;
+
+        // Color types stored as a datapod vector of channels (RGB, MONO, LAB, the float types, ...)
+        template <typename T>
+        concept Serializable =
+            requires {
+                typename color_traits<T>::channel_type;
+                color_traits<T>::channels;
+            } && std::is_trivially_copyable_v<T> &&
+            sizeof(T) == color_traits<T>::channels * sizeof(typename color_traits<T>::channel_type);
+
+        namespace detail {
+
+            template <typename T> Header make_header(Layout layout, size_t count, size_t payload_size) {
+                using traits = color_traits<T>;
+                Header header{};
+                std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+                header.version = VERSION;
+                header.element_size = static_cast<uint32_t>(sizeof(T));
+                header.channels = static_cast<uint8_t>(traits::channels);
+                header.channel_size = static_cast<uint8_t>(sizeof(typename traits::channel_type));
+                header.layout = layout;
+                header.count = count;
+                header.payload_size = payload_size;
+                return header;
+            }
+
+            template <typename T> void check_layout(Layout layout) {
+                if (layout == Layout::DELTA && !std::is_same_v<typename color_traits<T>::channel_type, uint8_t>) {
+                    throw std::invalid_argument("Delta layout needs a color type with 8-bit channels");
+                }
+                if (layout != Layout::INTERLEAVED && layout != Layout::PLANAR && layout != Layout::DELTA) {
+                    throw std::invalid_argument("Unknown serialization layout");
+                }
+            }
+
+            // Channel `c` of colors[i] minus the same channel of colors[i - 1], modulo 256
+            template <typename T> uint8_t delta(std::span<const T> colors, size_t c, size_t i) {
+                const uint8_t current = color_traits<T>::data(colors[i])[c];
+                const uint8_t previous = i ? color_traits<T>::data(colors[i - 1])[c] : 0;
+                return static_cast<uint8_t>(current - previous);
+            }
+
+            // PackBits over `n` bytes produced by `at(i)`: a control byte 0-127 is followed by that many + 1
+            // literals, 257 - control (129-255) repeats the following byte
+            template <typename At, typename Out> void pack_bits(size_t n, At at, Out &out) {
+                constexpr size_t MAX_RUN = 128;
+                size_t i = 0;
+                while (i < n) {
+                    size_t run = 1;
+                    const uint8_t value = at(i);
+                    while (i + run < n && run < MAX_RUN && at(i + run) == value) {
+                        ++run;
+                    }
+                    if (run >= 3) {
+                        out.put(static_cast<uint8_t>(257 - run));
+                        out.put(value);
+                        i += run;
+                        continue;
+                    }
+                    // Literals until the next run of three or the 128 limit
+                    size_t literals = 0;
+                    while (i + literals < n && literals < MAX_RUN) {
+                        const size_t j = i + literals;
+                        if (j + 2 < n && at(j) == at(j + 1) && at(j) == at(j + 2)) {
+                            break;
+                        }
+                        ++literals;
+                    }
+                    out.put(static_cast<uint8_t>(literals - 1));
+                    for (size_t k = 0; k < literals; ++k) {
+                        out.put(at(i + k));
+                    }
+                    i += literals;
+                }
+            }
+
+            // Payload writers; `write` is raw memory, `put` a single byte
+            class SpanWriter {
+                uint8_t *data_;
+                size_t size_;
+                size_t used_ = 0;
+
+              public:
+                explicit SpanWriter(std::span<uint8_t> out) : data_(out.data()), size_(out.size()) {}
+
+                size_t used() const { return used_; }
+
+                void write(const void *bytes, size_t n) {
+                    if (size_ - used_ < n) {
+                        throw std::invalid_argument("Destination buffer is too small for the serialized colors");
+                    }
+                    std::memcpy(data_ + used_, bytes, n);
+                    used_ += n;
+                }
+
+                void put(uint8_t byte) { write(&byte, 1); }
+            };
+
+            struct CountingWriter {
+                size_t used = 0;
+                void write(const void *, size_t n) { used += n; }
+                void put(uint8_t) { ++used; }
+            };
+
+            // Batches small writes so planar and delta payloads do not go through the stream byte by byte
+            class FileWriter {
+                std::ofstream &file_;
+                std::vector<uint8_t> chunk_;
+
+              public:
+                static constexpr size_t CHUNK_SIZE = 1 << 16;
+
+                explicit FileWriter(std::ofstream &file) : file_(file) { chunk_.reserve(CHUNK_SIZE); }
+                ~FileWriter() { flush(); }
+
+                void flush() {
+                    file_.write(reinterpret_cast<const char *>(chunk_.data()),
+                                static_cast<std::streamsize>(chunk_.size()));
+                    chunk_.clear();
+                }
+
+                void write(const void *bytes, size_t n) {
+                    if (n >= CHUNK_SIZE) {
+                        flush();
+                        file_.write(static_cast<const char *>(bytes), static_cast<std::streamsize>(n));
+                        return;
+                    }
+                    if (chunk_.size() + n > CHUNK_SIZE) {
+                        flush();
+                    }
+                    const uint8_t *p = static_cast<const uint8_t *>(bytes);
+                    chunk_.insert(chunk_.end(), p, p + n);
+                }
+
+                void put(uint8_t byte) {
+                    if (chunk_.size() == CHUNK_SIZE) {
+                        flush();
+                    }
+                    chunk_.push_back(byte);
+                }
+            };
+
+            template <typename T, typename Out> void encode(std::span<const T> colors, Layout layout, Out &out) {
+                using traits = color_traits<T>;
+                switch (layout) {
+                case Layout::INTERLEAVED:
+                    if (!colors.empty()) {
+                        out.write(colors.data(), colors.size_bytes());
+                    }
+                    return;
+                case Layout::PLANAR:
+                    for (size_t c = 0; c < traits::channels; ++c) {
+                        for (const T &color : colors) {
+                            out.write(traits::data(color) + c, sizeof(typename traits::channel_type));
+                        }
+                    }
+                    return;
+                case Layout::DELTA:
+                    if constexpr (std::is_same_v<typename traits::channel_type, uint8_t>) {
+                        for (size_t c = 0; c < traits::channels; ++c) {
+                            pack_bits(colors.size(), [&](size_t i) { return delta(colors, c, i); }, out);
+                        }
+                    }
+                    return;
+                }
+            }
+
+            template <typename T> size_t payload_size(std::span<const T> colors, Layout layout) {
+                if (layout != Layout::DELTA) {
+                    return colors.size_bytes();
+                }
+                CountingWriter counter;
+                encode(colors, layout, counter);
+                return counter.used;
+            }
+
+            [[noreturn]] inline void corrupt() { throw std::runtime_error("Serialized color payload is corrupt"); }
+
+        } // namespace detail
+
+        // Exact number of bytes serialize() / write() produce (the DELTA size needs one encoding pass)
+        template <Serializable T>
+        size_t serialized_size(std::span<const T> colors, Layout layout = Layout::INTERLEAVED) {
+            detail::check_layout<T>(layout);
+            return sizeof(Header) + detail::payload_size(colors, layout);
+        }
+
+        // Header and payload into a caller-owned buffer; returns the bytes used. Never allocates.
+        template <Serializable T>
+        size_t write(std::span<const T> colors, std::span<uint8_t> out, Layout layout = Layout::INTERLEAVED) {
+            const size_t payload = serialized_size(colors, layout) - sizeof(Header);
+            detail::SpanWriter writer(out);
+            const Header header = detail::make_header<T>(layout, colors.size(), payload);
+            writer.write(&header, sizeof(header));
+            detail::encode(colors, layout, writer);
+            return writer.used();
+        }
+
+        // Into a new buffer; `Buffer` is any resizable byte container (std::vector<uint8_t>, dp::ByteBuf, ...)
+        template <typename Buffer = std::vector<uint8_t>, Serializable T>
+        Buffer serialize(std::span<const T> colors, Layout layout = Layout::INTERLEAVED) {
+            Buffer buffer;
+            buffer.resize(serialized_size(colors, layout));
+            write(colors, std::span<uint8_t>(reinterpret_cast<uint8_t *>(buffer.data()), buffer.size()), layout);
+            return buffer;
+        }
+
+        template <typename Buffer = std::vector<uint8_t>, Serializable T>
+        Buffer serialize(const std::vector<T> &colors, Layout layout = Layout::INTERLEAVED) {
+            return serialize<Buffer>(std::span<const T>(colors), layout);
+        }
+
+        template <typename Buffer = std::vector<uint8_t>>
+        Buffer serialize(const Palette &palette, Layout layout = Layout::INTERLEAVED) {
+            return serialize<Buffer>(std::span<const RGB>(palette.begin(), palette.end()), layout);
+        }
+
+        // Stream straight to a file; INTERLEAVED data goes out in one write without a staging copy
+        template <Serializable T>
+        void save(const std::string &path, std::span<const T> colors, Layout layout = Layout::INTERLEAVED) {
+            const size_t payload = serialized_size(colors, layout) - sizeof(Header);
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            if (!file) {
+                throw std::runtime_error("Cannot open file for writing: " + path);
+            }
+            const Header header = detail::make_header<T>(layout, colors.size(), payload);
+            file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            {
+                detail::FileWriter writer(file);
+                detail::encode(colors, layout, writer);
+            }
+            if (!file) {
+                throw std::runtime_error("Failed writing serialized colors: " + path);
+            }
+        }
+
+        inline void save(const std::string &path, const Palette &palette, Layout layout = Layout::INTERLEAVED) {
+            save(path, std::span<const RGB>(palette.begin(), palette.end()), layout);
+        }
+
+        /**
+         * @brief Zero-copy reader over serialized colors
+         *
+         * Validates the header against T and points into the caller's bytes, which must outlive the view.
+         * INTERLEAVED data is exposed as a span of T and PLANAR data as one span per channel, both without
+         * copying; copy_to() decodes any layout.
+         */
+        template <Serializable T> class View {
+          public:
+            using traits = color_traits<T>;
+            using channel_type = typename traits::channel_type;
+            static constexpr size_t channels = traits::channels;
+
+          private:
+            Header header_{};
+            const uint8_t *payload_ = nullptr;
+
+            void require(Layout layout, const char *what) const {
+                if (header_.layout != layout) {
+                    throw std::logic_error(what);
+                }
+            }
+
+          public:
+            View() { header_ = detail::make_header<T>(Layout::INTERLEAVED, 0, 0); }
+
+            explicit View(std::span<const uint8_t> bytes) {
+                if (bytes.size() < sizeof(Header)) {
+                    throw std::runtime_error("Serialized colors are truncated");
+                }
+                std::memcpy(&header_, bytes.data(), sizeof(header_));
+                const Header expected = detail::make_header<T>(header_.layout, 0, 0);
+                if (std::memcmp(header_.magic, MAGIC, sizeof(MAGIC)) != 0 || header_.version != VERSION) {
+                    throw std::runtime_error("Not a serialized color buffer");
+                }
+                if (header_.element_size != expected.element_size || header_.channels != expected.channels ||
+                    header_.channel_size != expected.channel_size) {
+                    throw std::runtime_error("Serialized colors do not match this color type");
+                }
+                const size_t available = bytes.size() - sizeof(Header);
+                if (header_.payload_size > available) {
+                    throw std::runtime_error("Serialized colors are truncated");
+                }
+                switch (header_.layout) {
+                case Layout::INTERLEAVED:
+                case Layout::PLANAR:
+                    if (header_.count > available / sizeof(T) || header_.payload_size != header_.count * sizeof(T)) {
+                        detail::corrupt();
+                    }
+                    break;
+                case Layout::DELTA:
+                    // Every two payload bytes decode to at most 128 values (a maximal run), so a header claiming
+                    // more colors than that is corrupt; checked here so to_vector() never sizes off a bogus count
+                    if (!std::is_same_v<channel_type, uint8_t> ||
+                        header_.count > header_.payload_size / 2 * 128 / channels) {
+                        detail::corrupt();
+                    }
+                    break;
+                default:
+                    throw std::runtime_error("Unknown serialization layout");
+                }
+                payload_ = bytes.data() + sizeof(Header);
+                if (header_.layout != Layout::DELTA && reinterpret_cast<uintptr_t>(payload_) % alignof(T) != 0) {
+                    throw std::runtime_error("Serialized colors are not aligned for this color type");
+                }
+            }
+
+            const Header &header() const { return header_; }
+            Layout layout() const { return header_.layout; }
+            size_t size() const { return static_cast<size_t>(header_.count); }
+            bool empty() const { return header_.count == 0; }
+
+            // Raw payload bytes (after the header)
+            std::span<const uint8_t> payload() const { return {payload_, static_cast<size_t>(header_.payload_size)}; }
+
+            // The colors in place (INTERLEAVED only)
+            std::span<const T> colors() const {
+                require(Layout::INTERLEAVED, "Only interleaved serialized colors can be viewed as colors");
+                return {reinterpret_cast<const T *>(payload_), size()};
+            }
+
+            // One channel of every color in place (PLANAR only)
+            std::span<const channel_type> plane(size_t channel) const {
+                require(Layout::PLANAR, "Only planar serialized colors can be viewed as planes");
+                if (channel >= channels) {
+                    throw std::out_of_range("Channel index out of range");
+                }
+                return {reinterpret_cast<const channel_type *>(payload_) + channel * size(), size()};
+            }
+
+            // Decode into `out` (at least size() colors), whatever the layout
+            void copy_to(std::span<T> out) const {
+                if (out.size() < size()) {
+                    throw std::invalid_argument("Destination span is smaller than source span");
+                }
+                const size_t n = size();
+                switch (header_.layout) {
+                case Layout::INTERLEAVED:
+                    if (n) {
+                        std::memcpy(static_cast<void *>(out.data()), payload_, n * sizeof(T));
+                    }
+                    return;
+                case Layout::PLANAR:
+                    for (size_t c = 0; c < channels; ++c) {
+                        const uint8_t *src = payload_ + c * n * sizeof(channel_type);
+                        for (size_t i = 0; i < n; ++i) {
+                            std::memcpy(traits::data(out[i]) + c, src + i * sizeof(channel_type), sizeof(channel_type));
+                        }
+                    }
+                    return;
+                case Layout::DELTA:
+                    if constexpr (std::is_same_v<channel_type, uint8_t>) {
+                        decode_delta(out);
+                    }
+                    return;
+                }
+            }
+
+            std::vector<T> to_vector() const {
+                std::vector<T> out(size());
+                copy_to(out);
+                return out;
+            }
+
+          private:
+            void decode_delta(std::span<T> out) const {
+                const uint8_t *p = payload_;
+                const uint8_t *end = payload_ + header_.payload_size;
+                const size_t n = size();
+                for (size_t c = 0; c < channels; ++c) {
+                    uint8_t value = 0;
+                    size_t i = 0;
+                    while (i < n) {
+                        if (p == end) {
+                            detail::corrupt();
+                        }
+                        const uint8_t control = *p++;
+                        if (control < 128) {
+                            const size_t literals = size_t(control) + 1;
+                            if (literals > n - i || static_cast<size_t>(end - p) < literals) {
+                                detail::corrupt();
+                            }
+                            for (size_t k = 0; k < literals; ++k, ++i) {
+                                value = static_cast<uint8_t>(value + *p++);
+                                traits::data(out[i])[c] = value;
+                            }
+                        } else if (control > 128) {
+                            const size_t run = 257 - size_t(control);
+                            if (run > n - i || p == end) {
+                                detail::corrupt();
+                            }
+                            const uint8_t step = *p++;
+                            for (size_t k = 0; k < run; ++k, ++i) {
+                                value = static_cast<uint8_t>(value + step);
+                                traits::data(out[i])[c] = value;
+                            }
+                        }
+                    }
+                }
+                if (p != end) {
+                    detail::corrupt();
+                }
+            }
+        };
+
+        template <Serializable T> View<T> view(std::span<const uint8_t> bytes) { return View<T>(bytes); }
+
+        // Any contiguous byte container with data() / size() (std::vector<uint8_t>, dp::ByteBuf, ...)
+        template <Serializable T, typename Bytes>
+            requires requires(const Bytes &b) {
+                b.data();
+                b.size();
+            } && (sizeof(*std::declval<const Bytes &>().data()) == 1)
+        View<T> view(const Bytes &bytes) {
+            return View<T>(std::span<const uint8_t>(reinterpret_cast<const uint8_t *>(bytes.data()), bytes.size()));
+        }
+
+        inline Palette load_palette(std::span<const uint8_t> bytes) { return Palette(View<RGB>(bytes).to_vector()); }
+
+        /**
+         * @brief Serialized colors opened memory-mapped
+         *
+         * Owns the mapping, so view() stays valid for the object's lifetime. Opening costs the header check only;
+         * pages of an INTERLEAVED or PLANAR file are read when first touched. Move-only.
+         */
+        template <Serializable T> class Archive {
+          private:
+            MappedFile file_;
+            View<T> view_;
+
+          public:
+            explicit Archive(const std::string &path)
+                : file_(path), view_(std::span<const uint8_t>(file_.data(), file_.size())) {}
+
+            const View<T> &view() const { return view_; }
+            const View<T> *operator->() const { return &view_; }
+        };
+
+    } // namespace serialization
+} // namespace pigment
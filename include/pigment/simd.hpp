@@ -0,0 +1,344 @@
+#pragma once
+
+#include "types_basic.hpp"
+#include "types_lab.hpp"
+#include "types_oklab.hpp"
+#include "types_xyz.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// Instruction set selection follows the compiler flags set by the build (PIGMENT_ENABLE_SIMD adds -mavx2 -mfma on
+// x86 and relies on NEON being baseline on aarch64). PIGMENT_SIMD_DISABLED forces the scalar lanes everywhere.
+#if !defined(PIGMENT_SIMD_DISABLED)
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#define PIGMENT_SIMD_AVX2 1
+#elif defined(__SSE4_1__)
+#include <smmintrin.h>
+#define PIGMENT_SIMD_SSE4 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define PIGMENT_SIMD_NEON 1
+#endif
+#endif
+
+namespace pigment {
+    namespace simd {
+
+        // Magic constant for the bit-level cube root seed (Kahan), refined by Newton steps below
+        constexpr int32_t CBRT_SEED = 709921077;
+
+        /**
+         * @brief Single float lane
+         *
+         * Reference implementation of the lane interface. Used when no vector ISA is available and for the
+         * tail of every batch, so results do not depend on where a pixel falls in the buffer.
+         */
+        struct ScalarLanes {
+            using type = float;
+            static constexpr size_t width = 1;
+
+            static type load(const float *p) { return *p; }
+            static void store(float *p, type v) { *p = v; }
+            static type splat(float x) { return x; }
+            static type add(type a, type b) { return a + b; }
+            static type sub(type a, type b) { return a - b; }
+            static type mul(type a, type b) { return a * b; }
+            static type div(type a, type b) { return a / b; }
+            static type fmadd(type a, type b, type c) { return a * b + c; }
+            static type select_gt(type x, type threshold, type if_true, type if_false) {
+                return x > threshold ? if_true : if_false;
+            }
+            static type cbrt_seed(type x) {
+                int32_t bits;
+                std::memcpy(&bits, &x, sizeof(bits));
+                bits = static_cast<int32_t>(static_cast<float>(bits) * (1.0f / 3.0f)) + CBRT_SEED;
+                float seed;
+                std::memcpy(&seed, &bits, sizeof(seed));
+                return seed;
+            }
+        };
+
+#if defined(PIGMENT_SIMD_AVX2)
+        // Eight float lanes (AVX2 + FMA)
+        struct Avx2Lanes {
+            using type = __m256;
+            static constexpr size_t width = 8;
+
+            static type load(const float *p) { return _mm256_loadu_ps(p); }
+            static void store(float *p, type v) { _mm256_storeu_ps(p, v); }
+            static type splat(float x) { return _mm256_set1_ps(x); }
+            static type add(type a, type b) { return _mm256_add_ps(a, b); }
+            static type sub(type a, type b) { return _mm256_sub_ps(a, b); }
+            static type mul(type a, type b) { return _mm256_mul_ps(a, b); }
+            static type div(type a, type b) { return _mm256_div_ps(a, b); }
+            static type fmadd(type a, type b, type c) { return _mm256_fmadd_ps(a, b, c); }
+            static type select_gt(type x, type threshold, type if_true, type if_false) {
+                return _mm256_blendv_ps(if_false, if_true, _mm256_cmp_ps(x, threshold, _CMP_GT_OQ));
+            }
+            static type cbrt_seed(type x) {
+                __m256i bits = _mm256_castps_si256(x);
+                __m256 scaled = _mm256_mul_ps(_mm256_cvtepi32_ps(bits), _mm256_set1_ps(1.0f / 3.0f));
+                bits = _mm256_add_epi32(_mm256_cvttps_epi32(scaled), _mm256_set1_epi32(CBRT_SEED));
+                return _mm256_castsi256_ps(bits);
+            }
+        };
+        using NativeLanes = Avx2Lanes;
+#elif defined(PIGMENT_SIMD_SSE4)
+        // Four float lanes (SSE4.1)
+        struct Sse4Lanes {
+            using type = __m128;
+            static constexpr size_t width = 4;
+
+            static type load(const float *p) { return _mm_loadu_ps(p); }
+            static void store(float *p, type v) { _mm_storeu_ps(p, v); }
+            static type splat(float x) { return _mm_set1_ps(x); }
+            static type add(type a, type b) { return _mm_add_ps(a, b); }
+            static type sub(type a, type b) { return _mm_sub_ps(a, b); }
+            static type mul(type a, type b) { return _mm_mul_ps(a, b); }
+            static type div(type a, type b) { return _mm_div_ps(a, b); }
+            static type fmadd(type a, type b, type c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+            static type select_gt(type x, type threshold, type if_true, type if_false) {
+                return _mm_blendv_ps(if_false, if_true, _mm_cmpgt_ps(x, threshold));
+            }
+            static type cbrt_seed(type x) {
+                __m128i bits = _mm_castps_si128(x);
+                __m128 scaled = _mm_mul_ps(_mm_cvtepi32_ps(bits), _mm_set1_ps(1.0f / 3.0f));
+                bits = _mm_add_epi32(_mm_cvttps_epi32(scaled), _mm_set1_epi32(CBRT_SEED));
+                return _mm_castsi128_ps(bits);
+            }
+        };
+        using NativeLanes = Sse4Lanes;
+#elif defined(PIGMENT_SIMD_NEON)
+        // Four float lanes (AArch64 NEON)
+        struct NeonLanes {
+            using type = float32x4_t;
+            static constexpr size_t width = 4;
+
+            static type load(const float *p) { return vld1q_f32(p); }
+            static void store(float *p, type v) { vst1q_f32(p, v); }
+            static type splat(float x) { return vdupq_n_f32(x); }
+            static type add(type a, type b) { return vaddq_f32(a, b); }
+            static type sub(type a, type b) { return vsubq_f32(a, b); }
+            static type mul(type a, type b) { return vmulq_f32(a, b); }
+            static type div(type a, type b) { return vdivq_f32(a, b); }
+            static type fmadd(type a, type b, type c) { return vfmaq_f32(c, a, b); }
+            static type select_gt(type x, type threshold, type if_true, type if_false) {
+                return vbslq_f32(vcgtq_f32(x, threshold), if_true, if_false);
+            }
+            static type cbrt_seed(type x) {
+                int32x4_t bits = vreinterpretq_s32_f32(x);
+                float32x4_t scaled = vmulq_f32(vcvtq_f32_s32(bits), vdupq_n_f32(1.0f / 3.0f));
+                bits = vaddq_s32(vcvtq_s32_f32(scaled), vdupq_n_s32(CBRT_SEED));
+                return vreinterpretq_f32_s32(bits);
+            }
+        };
+        using NativeLanes = NeonLanes;
+#else
+        using NativeLanes = ScalarLanes;
+#endif
+
+        // Name of the instruction set the batch kernels were compiled for
+        constexpr const char *active_isa() {
+#if defined(PIGMENT_SIMD_AVX2)
+            return "avx2";
+#elif defined(PIGMENT_SIMD_SSE4)
+            return "sse4.1";
+#elif defined(PIGMENT_SIMD_NEON)
+            return "neon";
+#else
+            return "scalar";
+#endif
+        }
+
+        // Cube root for non-negative inputs: bit-level seed plus two Newton steps (max relative error ~2e-6)
+        template <typename L> inline typename L::type cbrt(typename L::type x) {
+            const auto two = L::splat(2.0f);
+            const auto third = L::splat(1.0f / 3.0f);
+            auto y = L::cbrt_seed(x);
+            y = L::mul(L::add(L::mul(two, y), L::div(x, L::mul(y, y))), third);
+            y = L::mul(L::add(L::mul(two, y), L::div(x, L::mul(y, y))), third);
+            return y;
+        }
+
+        // Row-major 3x3 matrix times column vector
+        template <typename L>
+        inline void mat3(const float (&m)[9], typename L::type r, typename L::type g, typename L::type b,
+                         typename L::type &x, typename L::type &y, typename L::type &z) {
+            x = L::fmadd(r, L::splat(m[0]), L::fmadd(g, L::splat(m[1]), L::mul(b, L::splat(m[2]))));
+            y = L::fmadd(r, L::splat(m[3]), L::fmadd(g, L::splat(m[4]), L::mul(b, L::splat(m[5]))));
+            z = L::fmadd(r, L::splat(m[6]), L::fmadd(g, L::splat(m[7]), L::mul(b, L::splat(m[8]))));
+        }
+
+        // Gather linear-light channels for one block of pixels from the gamma table
+        template <size_t W> inline void gather_linear(const RGB *src, float (&r)[W], float (&g)[W], float (&b)[W]) {
+            for (size_t j = 0; j < W; ++j) {
+                r[j] = lab_tables::gamma_to_linear_f[src[j].r()];
+                g[j] = lab_tables::gamma_to_linear_f[src[j].g()];
+                b[j] = lab_tables::gamma_to_linear_f[src[j].b()];
+            }
+        }
+
+        // sRGB -> XYZ (D65), with the white point normalisation used by LAB folded into the rows
+        constexpr float SRGB_TO_XYZ_D65_NORMALIZED[9] = {
+            0.4124564f / 0.95047f, 0.3575761f / 0.95047f, 0.1804375f / 0.95047f,
+            0.2126729f,            0.7151522f,            0.0721750f,
+            0.0193339f / 1.08883f, 0.1191920f / 1.08883f, 0.9503041f / 1.08883f};
+
+        // sRGB -> XYZ (D65) scaled to the 0-100 range used by XYZ
+        constexpr float SRGB_TO_XYZ_D65_SCALED[9] = {
+            0.4124564f * 95.047f, 0.3575761f * 95.047f, 0.1804375f * 95.047f,
+            0.2126729f * 100.0f,  0.7151522f * 100.0f,  0.0721750f * 100.0f,
+            0.0193339f * 108.883f, 0.1191920f * 108.883f, 0.9503041f * 108.883f};
+
+        // Linear sRGB -> LMS and LMS' -> Oklab (Ottosson)
+        constexpr float SRGB_TO_LMS[9] = {0.4122214708f, 0.5363325363f, 0.0514459929f,
+                                          0.2119034982f, 0.6806995451f, 0.1073969566f,
+                                          0.0883024619f, 0.2817188376f, 0.6299787005f};
+        constexpr float LMS_TO_OKLAB[9] = {0.2104542553f, 0.7936177850f,  -0.0040720468f,
+                                           1.9779984951f, -2.4285922050f, 0.4505937099f,
+                                           0.0259040371f, 0.7827717662f,  -0.8086757660f};
+
+        template <typename L> inline typename L::type lab_f(typename L::type t) {
+            return L::select_gt(t, L::splat(0.008856f), cbrt<L>(t),
+                                L::fmadd(t, L::splat(7.787f), L::splat(16.0f / 116.0f)));
+        }
+
+        // Color space math on linear-light lanes, shared by the interleaved and planar kernels.
+        // `has_alpha` tells the wrappers whether the target type carries the source alpha.
+        struct LabSpace {
+            static constexpr bool has_alpha = true;
+            static constexpr instrumentation::Counter counter = instrumentation::Counter::LAB_FROM_RGB;
+            template <typename L>
+            static void from_linear(typename L::type r, typename L::type g, typename L::type b, typename L::type &c0,
+                                    typename L::type &c1, typename L::type &c2) {
+                typename L::type x, y, z;
+                mat3<L>(SRGB_TO_XYZ_D65_NORMALIZED, r, g, b, x, y, z);
+                auto fx = lab_f<L>(x);
+                auto fy = lab_f<L>(y);
+                auto fz = lab_f<L>(z);
+                c0 = L::fmadd(fy, L::splat(116.0f), L::splat(-16.0f));
+                c1 = L::mul(L::sub(fx, fy), L::splat(500.0f));
+                c2 = L::mul(L::sub(fy, fz), L::splat(200.0f));
+            }
+        };
+
+        struct OklabSpace {
+            static constexpr bool has_alpha = false;
+            static constexpr instrumentation::Counter counter = instrumentation::Counter::OKLAB_FROM_RGB;
+            template <typename L>
+            static void from_linear(typename L::type r, typename L::type g, typename L::type b, typename L::type &c0,
+                                    typename L::type &c1, typename L::type &c2) {
+                typename L::type l, m, s;
+                mat3<L>(SRGB_TO_LMS, r, g, b, l, m, s);
+                mat3<L>(LMS_TO_OKLAB, cbrt<L>(l), cbrt<L>(m), cbrt<L>(s), c0, c1, c2);
+            }
+        };
+
+        struct XyzSpace {
+            static constexpr bool has_alpha = false;
+            static constexpr instrumentation::Counter counter = instrumentation::Counter::XYZ_FROM_RGB;
+            template <typename L>
+            static void from_linear(typename L::type r, typename L::type g, typename L::type b, typename L::type &c0,
+                                    typename L::type &c1, typename L::type &c2) {
+                mat3<L>(SRGB_TO_XYZ_D65_SCALED, r, g, b, c0, c1, c2);
+            }
+        };
+
+        // One block of interleaved RGB into any output type constructible from its float components
+        // (LAB/LABf, OKLAB/OKLABf, XYZ/XYZf)
+        template <typename L, typename Space, typename Out> inline void rgb_block(const RGB *src, Out *dst) {
+            constexpr size_t W = L::width;
+            alignas(32) float r[W], g[W], b[W];
+            gather_linear(src, r, g, b);
+
+            typename L::type c0, c1, c2;
+            Space::template from_linear<L>(L::load(r), L::load(g), L::load(b), c0, c1, c2);
+            L::store(r, c0);
+            L::store(g, c1);
+            L::store(b, c2);
+            for (size_t j = 0; j < W; ++j) {
+                if constexpr (Space::has_alpha) {
+                    dst[j] = Out(r[j], g[j], b[j], src[j].a());
+                } else {
+                    dst[j] = Out(r[j], g[j], b[j]);
+                }
+            }
+        }
+
+        // Store one lane block into a plane of float (directly) or double (through a staging buffer)
+        template <typename L, typename T> inline void store_plane(T *dst, typename L::type v) {
+            if constexpr (std::is_same_v<T, float>) {
+                L::store(dst, v);
+            } else {
+                alignas(32) float tmp[L::width];
+                L::store(tmp, v);
+                for (size_t j = 0; j < L::width; ++j) {
+                    dst[j] = static_cast<T>(tmp[j]);
+                }
+            }
+        }
+
+        // One block of planar RGB into three output planes
+        template <typename L, typename Space, typename T>
+        inline void planar_block(const uint8_t *r_in, const uint8_t *g_in, const uint8_t *b_in, T *out0, T *out1,
+                                 T *out2) {
+            constexpr size_t W = L::width;
+            alignas(32) float r[W], g[W], b[W];
+            for (size_t j = 0; j < W; ++j) {
+                r[j] = lab_tables::gamma_to_linear_f[r_in[j]];
+                g[j] = lab_tables::gamma_to_linear_f[g_in[j]];
+                b[j] = lab_tables::gamma_to_linear_f[b_in[j]];
+            }
+
+            typename L::type c0, c1, c2;
+            Space::template from_linear<L>(L::load(r), L::load(g), L::load(b), c0, c1, c2);
+            store_plane<L>(out0, c0);
+            store_plane<L>(out1, c1);
+            store_plane<L>(out2, c2);
+        }
+
+        // Interleaved driver: full native-width blocks first, then scalar lanes for the tail
+        template <typename Space, typename Out> inline void rgb_to_space(const RGB *src, Out *dst, size_t n) {
+            instrumentation::count(Space::counter, n);
+            constexpr size_t W = NativeLanes::width;
+            size_t i = 0;
+            for (; i + W <= n; i += W) {
+                rgb_block<NativeLanes, Space>(src + i, dst + i);
+            }
+            for (; i < n; ++i) {
+                rgb_block<ScalarLanes, Space>(src + i, dst + i);
+            }
+        }
+
+        // Planar driver over n pixels of one row
+        template <typename Space, typename T>
+        inline void planes_to_space(const uint8_t *r, const uint8_t *g, const uint8_t *b, T *out0, T *out1, T *out2,
+                                    size_t n) {
+            instrumentation::count(Space::counter, n);
+            constexpr size_t W = NativeLanes::width;
+            size_t i = 0;
+            for (; i + W <= n; i += W) {
+                planar_block<NativeLanes, Space>(r + i, g + i, b + i, out0 + i, out1 + i, out2 + i);
+            }
+            for (; i < n; ++i) {
+                planar_block<ScalarLanes, Space>(r + i, g + i, b + i, out0 + i, out1 + i, out2 + i);
+            }
+        }
+
+        // Batch kernels (float precision, exact cube root instead of the truncating lab_f table)
+        template <typename Out> inline void rgb_to_lab(const RGB *src, Out *dst, size_t n) {
+            rgb_to_space<LabSpace>(src, dst, n);
+        }
+        template <typename Out> inline void rgb_to_oklab(const RGB *src, Out *dst, size_t n) {
+            rgb_to_space<OklabSpace>(src, dst, n);
+        }
+        template <typename Out> inline void rgb_to_xyz(const RGB *src, Out *dst, size_t n) {
+            rgb_to_space<XyzSpace>(src, dst, n);
+        }
+
+    } // namespace simd
+} // namespace pigment
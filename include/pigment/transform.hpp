@@ -0,0 +1,278 @@
+#pragma once
+
+#include "lut3d.hpp"
+#include "parallel.hpp"
+#include "types_basic.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace pigment {
+
+    /**
+     * @brief Chain of HSL / HSV adjustments folded into as few stages as possible
+     *
+     * Every adjustment is a per-channel map: a hue rotation, or clamp(scale * x + offset) on saturation,
+     * lightness or value. Such maps compose into one map of the same form, so consecutive adjustments in the
+     * same space collapse into a single stage, and applying the chain costs one conversion into each space it
+     * visits (directly HSL <-> HSV between stages, through RGB only at the two ends). Everything runs in double
+     * precision and rounds to 8 bits once; the equivalent chain of HSL / HSV calls truncates to 8 bits after
+     * every step, so it drifts by a few levels from these results. Alpha passes through.
+     *
+     * Method names and parameters follow HSL (adjust_hue, saturate, lighten, ...) and, prefixed with hsv_,
+     * HSV::adjust_brightness / adjust_saturation. For many colors, to_lut() bakes the chain into a Lut3D.
+     */
+    class ColorTransform {
+      public:
+        enum class Space { HSL, HSV };
+
+        // clamp(scale * x + offset, low, high) on a channel in [0, 1]; scale is never negative
+        struct ChannelMap {
+            double scale = 1.0;
+            double offset = 0.0;
+            double low = 0.0;
+            double high = 1.0;
+
+            double operator()(double x) const { return std::clamp(scale * x + offset, low, high); }
+
+            // `next` after this one: clamps with a non-negative slope commute into a single clamp
+            ChannelMap then(const ChannelMap &next) const {
+                ChannelMap m;
+                m.scale = next.scale * scale;
+                m.offset = next.scale * offset + next.offset;
+                m.low = std::clamp(next.scale * low + next.offset, next.low, next.high);
+                m.high = std::clamp(next.scale * high + next.offset, next.low, next.high);
+                return m;
+            }
+        };
+
+        struct Stage {
+            Space space = Space::HSL;
+            double hue_shift = 0.0;  // degrees, in [0, 360)
+            ChannelMap saturation;   // HSL or HSV saturation
+            ChannelMap level;        // HSL lightness or HSV value
+        };
+
+      private:
+        std::vector<Stage> stages_;
+
+        // Hue in degrees [0, 360), the other two channels in [0, 1]
+        struct Triple {
+            double h, s, x;
+        };
+
+        Stage &stage(Space space) {
+            if (stages_.empty() || stages_.back().space != space) {
+                stages_.push_back(Stage{space, 0.0, {}, {}});
+            }
+            return stages_.back();
+        }
+
+        ColorTransform &rotate(Space space, double degrees) {
+            Stage &s = stage(space);
+            s.hue_shift = wrap_hue(s.hue_shift + degrees);
+            return *this;
+        }
+
+        ColorTransform &map(Space space, ChannelMap Stage::*channel, const ChannelMap &next) {
+            Stage &s = stage(space);
+            s.*channel = (s.*channel).then(next);
+            return *this;
+        }
+
+        static double wrap_hue(double h) {
+            h = std::fmod(h, 360.0);
+            return h < 0.0 ? h + 360.0 : h;
+        }
+
+        static ChannelMap affine(double scale, double offset) { return ChannelMap{scale, offset, 0.0, 1.0}; }
+
+        // HSV::adjust_* semantics: move toward 1 for delta > 0, toward 0 for delta < 0
+        static ChannelMap toward(double delta) {
+            delta = std::clamp(delta, -1.0, 1.0);
+            return delta > 0.0 ? affine(1.0 - delta, delta) : affine(1.0 + delta, 0.0);
+        }
+
+        static Triple rgb_to_hsl(double r, double g, double b) {
+            const double mx = std::max({r, g, b}), mn = std::min({r, g, b});
+            const double delta = mx - mn;
+            const double l = (mx + mn) / 2.0;
+            if (delta == 0.0) {
+                return {0.0, 0.0, l};
+            }
+            const double s = l > 0.5 ? delta / (2.0 - mx - mn) : delta / (mx + mn);
+            return {hue(r, g, b, mx, delta), s, l};
+        }
+
+        static Triple rgb_to_hsv(double r, double g, double b) {
+            const double mx = std::max({r, g, b}), mn = std::min({r, g, b});
+            const double delta = mx - mn;
+            if (delta == 0.0) {
+                return {0.0, 0.0, mx};
+            }
+            return {hue(r, g, b, mx, delta), delta / mx, mx};
+        }
+
+        // Shared by HSL and HSV, same formula as HSL::fromRGB
+        static double hue(double r, double g, double b, double mx, double delta) {
+            double h;
+            if (mx == r) {
+                h = (g - b) / delta + (g < b ? 6.0 : 0.0);
+            } else if (mx == g) {
+                h = (b - r) / delta + 2.0;
+            } else {
+                h = (r - g) / delta + 4.0;
+            }
+            return wrap_hue(h * 60.0);
+        }
+
+        static Triple hsl_to_hsv(const Triple &c) {
+            const double v = c.x + c.s * std::min(c.x, 1.0 - c.x);
+            return {c.h, v > 0.0 ? 2.0 * (1.0 - c.x / v) : 0.0, v};
+        }
+
+        static Triple hsv_to_hsl(const Triple &c) {
+            const double l = c.x * (1.0 - c.s / 2.0);
+            const double m = std::min(l, 1.0 - l);
+            return {c.h, m > 0.0 ? (c.x - l) / m : 0.0, l};
+        }
+
+        // Chroma-based inverse, valid for both spaces once expressed as HSV
+        static void hsv_to_rgb(const Triple &c, double rgb[3]) {
+            const double chroma = c.x * c.s;
+            const double sector = c.h / 60.0;
+            const double second = chroma * (1.0 - std::fabs(std::fmod(sector, 2.0) - 1.0));
+            const double m = c.x - chroma;
+            double r = 0.0, g = 0.0, b = 0.0;
+            switch (static_cast<int>(sector) % 6) {
+            case 0:
+                r = chroma, g = second;
+                break;
+            case 1:
+                r = second, g = chroma;
+                break;
+            case 2:
+                g = chroma, b = second;
+                break;
+            case 3:
+                g = second, b = chroma;
+                break;
+            case 4:
+                r = second, b = chroma;
+                break;
+            default:
+                r = chroma, b = second;
+                break;
+            }
+            rgb[0] = r + m;
+            rgb[1] = g + m;
+            rgb[2] = b + m;
+        }
+
+        static uint8_t to_byte(double v) { return static_cast<uint8_t>(std::clamp(v, 0.0, 1.0) * 255.0 + 0.5); }
+
+        static Triple convert(const Triple &c, Space from, Space to) {
+            if (from == to) {
+                return c;
+            }
+            return to == Space::HSV ? hsl_to_hsv(c) : hsv_to_hsl(c);
+        }
+
+      public:
+        ColorTransform() = default;
+
+        // ---- HSL stages (same parameters as the HSL methods) ----
+        ColorTransform &adjust_hue(double degrees) { return rotate(Space::HSL, degrees); }
+        ColorTransform &adjust_saturation(double factor) {
+            return map(Space::HSL, &Stage::saturation, affine(std::max(factor, 0.0), 0.0));
+        }
+        ColorTransform &adjust_lightness(double factor) {
+            return map(Space::HSL, &Stage::level, affine(std::max(factor, 0.0), 0.0));
+        }
+        ColorTransform &saturate(double amount = 0.1) {
+            return map(Space::HSL, &Stage::saturation, affine(1.0, amount));
+        }
+        ColorTransform &desaturate(double amount = 0.1) { return saturate(-amount); }
+        ColorTransform &lighten(double amount = 0.1) { return map(Space::HSL, &Stage::level, affine(1.0, amount)); }
+        ColorTransform &darken(double amount = 0.1) { return lighten(-amount); }
+
+        // ---- HSV stages (same parameters as the HSV methods) ----
+        ColorTransform &hsv_adjust_hue(double degrees) { return rotate(Space::HSV, degrees); }
+        ColorTransform &hsv_adjust_saturation(double delta) {
+            return map(Space::HSV, &Stage::saturation, toward(delta));
+        }
+        ColorTransform &hsv_adjust_brightness(double delta) { return map(Space::HSV, &Stage::level, toward(delta)); }
+
+        // Append another chain; its first stage merges with this one's last when they share a space
+        ColorTransform &then(const ColorTransform &next) {
+            for (const Stage &s : next.stages_) {
+                Stage &merged = stage(s.space);
+                merged.hue_shift = wrap_hue(merged.hue_shift + s.hue_shift);
+                merged.saturation = merged.saturation.then(s.saturation);
+                merged.level = merged.level.then(s.level);
+            }
+            return *this;
+        }
+
+        const std::vector<Stage> &stages() const { return stages_; }
+        bool empty() const { return stages_.empty(); }
+
+        RGB apply(const RGB &color) const {
+            if (stages_.empty()) {
+                return color;
+            }
+            const double r = color.r() / 255.0, g = color.g() / 255.0, b = color.b() / 255.0;
+            Space space = stages_.front().space;
+            Triple c = space == Space::HSL ? rgb_to_hsl(r, g, b) : rgb_to_hsv(r, g, b);
+            for (const Stage &s : stages_) {
+                c = convert(c, space, s.space);
+                space = s.space;
+                c.h = s.hue_shift == 0.0 ? c.h : wrap_hue(c.h + s.hue_shift);
+                c.s = s.saturation(c.s);
+                c.x = s.level(c.x);
+            }
+            double out[3];
+            hsv_to_rgb(convert(c, space, Space::HSV), out);
+            return RGB(to_byte(out[0]), to_byte(out[1]), to_byte(out[2]), color.a());
+        }
+
+        RGB operator()(const RGB &color) const { return apply(color); }
+
+        // Batch; `dst` may alias `src`
+        void apply(std::span<const RGB> src, std::span<RGB> dst) const {
+            PIGMENT_SCOPE_N("ColorTransform::apply", src.size());
+            if (dst.size() < src.size()) {
+                throw std::invalid_argument("Destination span is smaller than source span");
+            }
+            for (size_t i = 0; i < src.size(); ++i) {
+                dst[i] = apply(src[i]);
+            }
+        }
+
+        // Tiled batch for large buffers
+        template <typename Executor>
+        void apply(std::span<const RGB> src, std::span<RGB> dst, Executor &&executor,
+                   size_t tile_size = parallel::DEFAULT_TILE_SIZE) const {
+            if (dst.size() < src.size()) {
+                throw std::invalid_argument("Destination span is smaller than source span");
+            }
+            parallel::for_each_tile(
+                src.size(), executor,
+                [&](size_t begin, size_t end) {
+                    apply(src.subspan(begin, end - begin), dst.subspan(begin, end - begin));
+                },
+                tile_size);
+        }
+
+        // The whole chain as a lookup cube; cheaper per pixel than apply() on large images, at the cost of
+        // interpolation error where the chain bends sharply (hue wrap, saturation clamps), so prefer a LARGE cube
+        // for strong adjustments
+        Lut3D to_lut(size_t size = Lut3D::MEDIUM) const {
+            return Lut3D::bake([this](const RGB &c) { return apply(c); }, size);
+        }
+    };
+
+} // namespace pigment
@@ -2,14 +2,21 @@
 
 #include <datapod/datapod.hpp>
 
+#include "instrumentation.hpp"
+#include "random.hpp"
+
 #include <algorithm>
+#include <charconv>
 #include <cmath>
 #include <cstdint>
+#include <cstring>
 #include <iomanip>
+#include <optional>
 #include <random>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <variant>
 #include <vector>
@@ -26,6 +33,57 @@ namespace pigment {
     struct XYZ;
     struct OKLAB;
     struct LCH;
+    struct LABf;
+    struct XYZf;
+    struct OKLABf;
+    struct LCHf;
+
+    namespace text_detail {
+
+        // Value of a hex digit, -1 if `c` is not one
+        constexpr int hex_digit(char c) {
+            if (c >= '0' && c <= '9') {
+                return c - '0';
+            }
+            if (c >= 'a' && c <= 'f') {
+                return c - 'a' + 10;
+            }
+            if (c >= 'A' && c <= 'F') {
+                return c - 'A' + 10;
+            }
+            return -1;
+        }
+
+        inline char *write_hex_byte(char *out, uint8_t value) {
+            constexpr char digits[] = "0123456789abcdef";
+            *out++ = digits[value >> 4];
+            *out++ = digits[value & 0xF];
+            return out;
+        }
+
+        inline const char *skip_spaces(const char *p, const char *last) {
+            while (p != last && (*p == ' ' || *p == '\t')) {
+                ++p;
+            }
+            return p;
+        }
+
+        // CSS alpha fraction to 8 bits, truncating; clamped in double so large values cannot overflow the cast.
+        // `value` must be finite.
+        inline uint8_t alpha_byte(double value) {
+            return static_cast<uint8_t>(std::clamp(value * 255.0, 0.0, 255.0));
+        }
+
+        inline const char *skip_fraction(const char *p, const char *last) {
+            if (p != last && *p == '.') {
+                do {
+                    ++p;
+                } while (p != last && *p >= '0' && *p <= '9');
+            }
+            return p;
+        }
+
+    } // namespace text_detail
 
     /**
      * @brief RGB color type built on datapod::mat::Vector<uint8_t, 4>
@@ -61,6 +119,9 @@ namespace pigment {
             data_[3] = a_;
         }
 
+        // Parses "#rgb", "#rrggbb", "#rrggbbaa" ('#' optional) and CSS "rgb(r,g,b)" / "rgba(r,g,b,a)". Lenient:
+        // spaces anywhere inside rgb() are dropped, a trailing comma is allowed and hex pairs are read like
+        // std::stoi (leading digits only). Use parse() for strict validation without exceptions.
         RGB(const std::string &color_str) {
             data_[3] = 255; // Default alpha
 
@@ -69,7 +130,7 @@ namespace pigment {
             }
 
             // Check if it's a CSS rgb() or rgba() function
-            if (color_str.substr(0, 4) == "rgb(" || color_str.substr(0, 5) == "rgba(") {
+            if (is_css_rgb(color_str)) {
                 parse_css_rgb(color_str);
                 return;
             }
@@ -100,7 +161,99 @@ namespace pigment {
             data_[3] = std::stoi(h.substr(6, 2), nullptr, 16);
         }
 
+        // Non-allocating parsers: std::nullopt on malformed input, never throw
+
+        // Hex forms only; constexpr so literals can be checked at compile time (see literals::operator""_rgb)
+        static constexpr std::optional<RGB> parse_hex(std::string_view hex) {
+            if (!hex.empty() && hex.front() == '#') {
+                hex.remove_prefix(1);
+            }
+            int digits[8] = {};
+            if (hex.size() != 3 && hex.size() != 6 && hex.size() != 8) {
+                return std::nullopt;
+            }
+            for (size_t i = 0; i < hex.size(); ++i) {
+                digits[i] = text_detail::hex_digit(hex[i]);
+                if (digits[i] < 0) {
+                    return std::nullopt;
+                }
+            }
+            if (hex.size() == 3) {
+                return RGB(static_cast<uint8_t>(digits[0] * 17), static_cast<uint8_t>(digits[1] * 17),
+                           static_cast<uint8_t>(digits[2] * 17), 255);
+            }
+            auto byte = [&](size_t i) { return static_cast<uint8_t>(digits[2 * i] * 16 + digits[2 * i + 1]); };
+            return RGB(byte(0), byte(1), byte(2), hex.size() == 8 ? byte(3) : uint8_t(255));
+        }
+
+        // "rgb(r, g, b)" / "rgba(r, g, b, a)": channels are clamped integers, alpha is a [0, 1] fraction
+        static std::optional<RGB> parse_css(std::string_view css) {
+            if (!is_css_rgb(css)) {
+                return std::nullopt;
+            }
+            const size_t open = css.find('(');
+            const size_t close = css.find(')', open);
+            if (close == std::string_view::npos) {
+                return std::nullopt;
+            }
+            const char *p = css.data() + open + 1;
+            const char *last = css.data() + close;
+
+            int channels[3] = {};
+            uint8_t alpha = 255;
+            size_t count = 0;
+            while (true) {
+                p = text_detail::skip_spaces(p, last);
+                if (count < 3) {
+                    if (p != last && *p == '+') {
+                        ++p;
+                    }
+                    auto [next, ec] = std::from_chars(p, last, channels[count]);
+                    if (ec != std::errc()) {
+                        return std::nullopt;
+                    }
+                    p = text_detail::skip_fraction(next, last); // "12.7" truncates like the integer parser
+                } else if (count == 3) {
+                    double value = 0.0;
+                    auto [next, ec] = std::from_chars(p, last, value);
+                    if (ec != std::errc() || !std::isfinite(value)) {
+                        return std::nullopt; // from_chars also reads "nan" and "inf"
+                    }
+                    alpha = text_detail::alpha_byte(value);
+                    p = next;
+                } else {
+                    return std::nullopt;
+                }
+                ++count;
+                p = text_detail::skip_spaces(p, last);
+                if (p == last) {
+                    break;
+                }
+                if (*p != ',') {
+                    return std::nullopt;
+                }
+                ++p;
+            }
+            if (count < 3) {
+                return std::nullopt;
+            }
+            return RGB(static_cast<uint8_t>(std::clamp(channels[0], 0, 255)),
+                       static_cast<uint8_t>(std::clamp(channels[1], 0, 255)),
+                       static_cast<uint8_t>(std::clamp(channels[2], 0, 255)), alpha);
+        }
+
+        // Hex or CSS form, strictly: every hex character must be a digit and rgb() takes exactly 3 or 4
+        // comma-separated numbers. Anything parse() accepts, the string constructor reads the same way; the
+        // constructor also tolerates some malformed input (see above) that parse() rejects.
+        static std::optional<RGB> parse(std::string_view str) {
+            return is_css_rgb(str) ? parse_css(str) : parse_hex(str);
+        }
+
       private:
+        static constexpr bool is_css_rgb(std::string_view str) {
+            return str.starts_with("rgb(") || str.starts_with("rgba(");
+        }
+
         void parse_css_rgb(const std::string &css_str) {
             // Remove spaces and find the parentheses
             std::string clean = css_str;
@@ -135,9 +288,14 @@ namespace pigment {
             data_[0] = static_cast<uint8_t>(std::clamp(std::stoi(parts[0]), 0, 255));
             data_[1] = static_cast<uint8_t>(std::clamp(std::stoi(parts[1]), 0, 255));
             data_[2] = static_cast<uint8_t>(std::clamp(std::stoi(parts[2]), 0, 255));
-            data_[3] = parts.size() == 4
-                           ? static_cast<uint8_t>(std::clamp(static_cast<int>(std::stod(parts[3]) * 255), 0, 255))
-                           : 255;
+            data_[3] = 255;
+            if (parts.size() == 4) {
+                const double alpha = std::stod(parts[3]);
+                if (!std::isfinite(alpha)) {
+                    throw std::invalid_argument("Invalid CSS alpha: '" + css_str + "'");
+                }
+                data_[3] = text_detail::alpha_byte(alpha);
+            }
         }
 
       public:
@@ -149,23 +307,43 @@ namespace pigment {
         }
 
         // Implicit conversions from other color types
-        RGB(const MONO &mono);   // Defined after MONO is complete
-        RGB(const HSL &hsl);     // Defined after HSL is complete
-        RGB(const HSV &hsv);     // Defined after HSV is complete
-        RGB(const LAB &lab);     // Defined after LAB is complete
-        RGB(const XYZ &xyz);     // Defined after XYZ is complete
-        RGB(const OKLAB &oklab); // Defined after OKLAB is complete
-        RGB(const LCH &lch);     // Defined after LCH is complete
+        RGB(const MONO &mono);    // Defined after MONO is complete
+        RGB(const HSL &hsl);      // Defined after HSL is complete
+        RGB(const HSV &hsv);      // Defined after HSV is complete
+        RGB(const LAB &lab);      // Defined after LAB is complete
+        RGB(const XYZ &xyz);      // Defined after XYZ is complete
+        RGB(const OKLAB &oklab);  // Defined after OKLAB is complete
+        RGB(const LCH &lch);      // Defined after LCH is complete
+        RGB(const LABf &lab);     // Defined after LABf is complete
+        RGB(const XYZf &xyz);     // Defined after XYZf is complete
+        RGB(const OKLABf &oklab); // Defined after OKLABf is complete
+        RGB(const LCHf &lch);     // Defined after LCHf is complete
+
+        // Longest to_hex() output: "#rrggbbaa"
+        static constexpr size_t HEX_MAX_LENGTH = 9;
+
+        // Write "#rrggbb" (plus "aa" when include_alpha and not opaque) to `out` without a terminator;
+        // returns one past the last character written
+        char *to_hex(char *out, bool include_alpha = false) const {
+            *out++ = '#';
+            out = text_detail::write_hex_byte(out, r());
+            out = text_detail::write_hex_byte(out, g());
+            out = text_detail::write_hex_byte(out, b());
+            if (include_alpha && a() != 255) {
+                out = text_detail::write_hex_byte(out, a());
+            }
+            return out;
+        }
+
+        template <typename OutputIt> OutputIt format_to(OutputIt out, bool include_alpha = false) const {
+            char buffer[HEX_MAX_LENGTH];
+            return std::copy(buffer, to_hex(buffer, include_alpha), out);
+        }
 
         // Convert to hex string
         std::string to_hex(bool include_alpha = false) const {
-            std::stringstream ss;
-            ss << "#" << std::hex << std::setfill('0') << std::setw(2) << static_cast<int>(r()) << std::setw(2)
-               << static_cast<int>(g()) << std::setw(2) << static_cast<int>(b());
-            if (include_alpha && a() != 255) {
-                ss << std::setw(2) << static_cast<int>(a());
-            }
-            return ss.str();
+            char buffer[HEX_MAX_LENGTH];
+            return std::string(buffer, to_hex(buffer, include_alpha));
         }
 
         // Arithmetic operations
@@ -202,7 +380,15 @@ namespace pigment {
         }
 
         bool operator==(const RGB &other) const {
-            return r() == other.r() && g() == other.g() && b() == other.b() && a() == other.a();
+            if constexpr (sizeof(base_type) == 4) {
+                // One 32-bit compare instead of four short-circuited byte compares
+                uint32_t lhs, rhs;
+                std::memcpy(&lhs, &data_[0], sizeof(lhs));
+                std::memcpy(&rhs, &other.data_[0], sizeof(rhs));
+                return lhs == rhs;
+            } else {
+                return r() == other.r() && g() == other.g() && b() == other.b() && a() == other.a();
+            }
         }
 
         bool operator!=(const RGB &other) const { return !(*this == other); }
@@ -365,13 +551,15 @@ namespace pigment {
                        std::clamp(static_cast<int>(factor * (b() - 128) + 128), 0, 255), a());
         }
 
-        static RGB random() {
-            static std::random_device rd;
-            static std::mt19937 gen(rd());
+        // Uniform opaque color from `gen` (any UniformRandomBitGenerator)
+        template <typename URBG> static RGB random(URBG &gen) {
             std::uniform_int_distribution<int> dist(0, 255);
             return RGB(dist(gen), dist(gen), dist(gen), 255);
         }
 
+        // Same, drawn from the calling thread's engine
+        static RGB random() { return random(rng::engine()); }
+
         // Predefined colors
         static RGB black() { return RGB(0, 0, 0); }
         static RGB white() { return RGB(255, 255, 255); }
@@ -453,26 +641,49 @@ namespace pigment {
                         static_cast<uint8_t>(a() * (1 - clamped_ratio) + other.a() * clamped_ratio));
         }
 
+        // Write "#vv" to `out` without a terminator; returns one past the last character written
+        char *to_hex(char *out) const {
+            *out++ = '#';
+            return text_detail::write_hex_byte(out, v());
+        }
+
+        template <typename OutputIt> OutputIt format_to(OutputIt out) const {
+            char buffer[3];
+            return std::copy(buffer, to_hex(buffer), out);
+        }
+
         // Convert to hex string
         std::string to_hex() const {
-            std::stringstream ss;
-            ss << "#" << std::hex << std::setfill('0') << std::setw(2) << static_cast<int>(v());
-            return ss.str();
+            char buffer[3];
+            return std::string(buffer, to_hex(buffer));
         }
 
-        static MONO random() {
-            static std::random_device rd;
-            static std::mt19937 gen(rd());
+        template <typename URBG> static MONO random(URBG &gen) {
             std::uniform_int_distribution<int> dist(0, 255);
             return MONO(dist(gen), 255);
         }
 
+        static MONO random() { return random(rng::engine()); }
+
         // Predefined values
         static MONO black() { return MONO(0); }
         static MONO white() { return MONO(255); }
         static MONO gray() { return MONO(128); }
     };
 
+    namespace literals {
+
+        // Compile-time checked hex color literal: "#ff8000"_rgb
+        consteval RGB operator""_rgb(const char *str, size_t length) {
+            std::optional<RGB> color = RGB::parse_hex(std::string_view(str, length));
+            if (!color) {
+                throw std::invalid_argument("Invalid hex color literal");
+            }
+            return *color;
+        }
+
+    } // namespace literals
+
     // Implementation of RGB conversion constructor for MONO
     inline RGB::RGB(const MONO &mono) {
         data_[0] = mono.v();
@@ -0,0 +1,235 @@
+#pragma once
+
+#include "types_basic.hpp"
+#include "types_lab.hpp"
+#include "types_lch.hpp"
+#include "types_oklab.hpp"
+#include "types_xyz.hpp"
+
+#include <cmath>
+
+namespace pigment {
+
+    /**
+     * @brief Single-precision LAB built on datapod::mat::Vector<float, 4>
+     *
+     * Same layout and accessors as LAB at half the size (16 bytes), for large intermediate buffers.
+     * Scalar conversions go through LAB at Precision::EXACT, whatever lab_tables::DEFAULT_PRECISION is, so they
+     * agree with the batch API (written by the float kernels) to float rounding rather than to the LUT's error.
+     */
+    struct LABf : public datapod::mat::Vector<float, 4> {
+        using base_type = datapod::mat::Vector<float, 4>;
+
+        // Accessors for color components
+        float &l() { return data_[0]; }
+        float &a() { return data_[1]; }
+        float &b() { return data_[2]; }
+        float &alpha() { return data_[3]; }
+
+        const float &l() const { return data_[0]; }
+        const float &a() const { return data_[1]; }
+        const float &b() const { return data_[2]; }
+        const float &alpha() const { return data_[3]; }
+
+        LABf() {
+            data_[0] = 0.0f;
+            data_[1] = 0.0f;
+            data_[2] = 0.0f;
+            data_[3] = 255.0f;
+        }
+
+        LABf(float l_, float a_, float b_, float alpha_ = 255.0f) {
+            data_[0] = l_;
+            data_[1] = a_;
+            data_[2] = b_;
+            data_[3] = alpha_;
+        }
+
+        explicit LABf(const LAB &lab)
+            : LABf(static_cast<float>(lab.l()), static_cast<float>(lab.a()), static_cast<float>(lab.b()),
+                   static_cast<float>(lab.alpha())) {}
+
+        LAB to_lab() const { return LAB(l(), a(), b(), alpha()); }
+
+        static LABf fromRGB(const RGB &rgb) { return LABf(LAB::fromRGB<lab_tables::Precision::EXACT>(rgb)); }
+
+        RGB to_rgb() const { return to_lab().to_rgb<lab_tables::Precision::EXACT>(); }
+
+        // Delta E (CIE76)
+        float delta_e(const LABf &other) const {
+            float dl = l() - other.l();
+            float da = a() - other.a();
+            float db = b() - other.b();
+            return std::sqrt(dl * dl + da * da + db * db);
+        }
+    };
+
+    /**
+     * @brief Single-precision OKLAB built on datapod::mat::Vector<float, 3>
+     *
+     * Same layout and accessors as OKLAB at half the size (12 bytes).
+     */
+    struct OKLABf : public datapod::mat::Vector<float, 3> {
+        using base_type = datapod::mat::Vector<float, 3>;
+
+        // Accessors for color components
+        float &l() { return data_[0]; }
+        float &a() { return data_[1]; }
+        float &b() { return data_[2]; }
+
+        const float &l() const { return data_[0]; }
+        const float &a() const { return data_[1]; }
+        const float &b() const { return data_[2]; }
+
+        OKLABf() {
+            data_[0] = 0.0f;
+            data_[1] = 0.0f;
+            data_[2] = 0.0f;
+        }
+
+        OKLABf(float l_, float a_, float b_) {
+            data_[0] = l_;
+            data_[1] = a_;
+            data_[2] = b_;
+        }
+
+        explicit OKLABf(const OKLAB &oklab)
+            : OKLABf(static_cast<float>(oklab.l()), static_cast<float>(oklab.a()), static_cast<float>(oklab.b())) {}
+
+        OKLAB to_oklab() const { return OKLAB(l(), a(), b()); }
+
+        static OKLABf fromRGB(const RGB &rgb) { return OKLABf(OKLAB::fromRGB(rgb)); }
+
+        RGB to_rgb() const { return to_oklab().to_rgb(); }
+
+        // Perceptual distance to another color
+        float distance(const OKLABf &other) const {
+            float dl = l() - other.l();
+            float da = a() - other.a();
+            float db = b() - other.b();
+            return std::sqrt(dl * dl + da * da + db * db);
+        }
+    };
+
+    /**
+     * @brief Single-precision XYZ built on datapod::mat::Vector<float, 3>
+     *
+     * Same layout and accessors as XYZ at half the size (12 bytes).
+     */
+    struct XYZf : public datapod::mat::Vector<float, 3> {
+        using base_type = datapod::mat::Vector<float, 3>;
+
+        // Accessors for color components
+        float &x() { return data_[0]; }
+        float &y() { return data_[1]; }
+        float &z() { return data_[2]; }
+
+        const float &x() const { return data_[0]; }
+        const float &y() const { return data_[1]; }
+        const float &z() const { return data_[2]; }
+
+        XYZf() {
+            data_[0] = 0.0f;
+            data_[1] = 0.0f;
+            data_[2] = 0.0f;
+        }
+
+        XYZf(float x_, float y_, float z_) {
+            data_[0] = x_;
+            data_[1] = y_;
+            data_[2] = z_;
+        }
+
+        explicit XYZf(const XYZ &xyz)
+            : XYZf(static_cast<float>(xyz.x()), static_cast<float>(xyz.y()), static_cast<float>(xyz.z())) {}
+
+        XYZ to_xyz() const { return XYZ(x(), y(), z()); }
+
+        static XYZf fromRGB(const RGB &rgb) { return XYZf(XYZ::fromRGB(rgb)); }
+
+        RGB to_rgb() const { return to_xyz().to_rgb(); }
+
+        // Get luminance (Y component represents luminance)
+        float luminance() const { return y(); }
+    };
+
+    /**
+     * @brief Single-precision LCH built on datapod::mat::Vector<float, 3>
+     *
+     * Same layout and accessors as LCH at half the size (12 bytes). Converts through LAB at Precision::EXACT,
+     * like LABf.
+     */
+    struct LCHf : public datapod::mat::Vector<float, 3> {
+        using base_type = datapod::mat::Vector<float, 3>;
+
+        // Accessors for color components
+        float &l() { return data_[0]; }
+        float &c() { return data_[1]; }
+        float &h() { return data_[2]; }
+
+        const float &l() const { return data_[0]; }
+        const float &c() const { return data_[1]; }
+        const float &h() const { return data_[2]; }
+
+        LCHf() {
+            data_[0] = 0.0f;
+            data_[1] = 0.0f;
+            data_[2] = 0.0f;
+        }
+
+        LCHf(float l_, float c_, float h_) {
+            data_[0] = l_;
+            data_[1] = c_;
+            data_[2] = h_;
+        }
+
+        explicit LCHf(const LCH &lch)
+            : LCHf(static_cast<float>(lch.l()), static_cast<float>(lch.c()), static_cast<float>(lch.h())) {}
+
+        LCH to_lch() const { return LCH(l(), c(), h()); }
+
+        static LCHf fromLAB(const LABf &lab) { return LCHf(LCH::fromLAB(lab.to_lab())); }
+
+        static LCHf fromRGB(const RGB &rgb) {
+            return LCHf(LCH::fromLAB(LAB::fromRGB<lab_tables::Precision::EXACT>(rgb)));
+        }
+
+        LABf to_lab() const { return LABf(to_lch().to_lab()); }
+
+        RGB to_rgb() const { return to_lch().to_lab().to_rgb<lab_tables::Precision::EXACT>(); }
+    };
+
+    // Implementation of RGB conversion constructors for the float types
+    inline RGB::RGB(const LABf &lab) {
+        RGB temp = lab.to_rgb();
+        data_[0] = temp.r();
+        data_[1] = temp.g();
+        data_[2] = temp.b();
+        data_[3] = temp.a();
+    }
+
+    inline RGB::RGB(const OKLABf &oklab) {
+        RGB temp = oklab.to_rgb();
+        data_[0] = temp.r();
+        data_[1] = temp.g();
+        data_[2] = temp.b();
+        data_[3] = temp.a();
+    }
+
+    inline RGB::RGB(const XYZf &xyz) {
+        RGB temp = xyz.to_rgb();
+        data_[0] = temp.r();
+        data_[1] = temp.g();
+        data_[2] = temp.b();
+        data_[3] = temp.a();
+    }
+
+    inline RGB::RGB(const LCHf &lch) {
+        RGB temp = lch.to_rgb();
+        data_[0] = temp.r();
+        data_[1] = temp.g();
+        data_[2] = temp.b();
+        data_[3] = temp.a();
+    }
+
+} // namespace pigment
@@ -140,6 +140,7 @@ namespace pigment {
 
         // Convert from RGB
         static HSL fromRGB(const RGB &rgb) {
+            PIGMENT_COUNT(HSL_FROM_RGB);
             double r_val = rgb.r() / 255.0;
             double g_val = rgb.g() / 255.0;
             double b_val = rgb.b() / 255.0;
@@ -183,6 +184,7 @@ namespace pigment {
 
         // Convert to RGB
         RGB to_rgb() const {
+            PIGMENT_COUNT(HSL_TO_RGB);
             double l_norm = l / 255.0;
             double s_norm = s / 255.0;
 
@@ -275,20 +277,21 @@ namespace pigment {
             return {*this, adjust_hue(180.0 - angle), adjust_hue(180.0 + angle)};
         }
 
-        static HSL random() {
-            static std::random_device rd;
-            static std::mt19937 gen(rd());
+        // Uniform over the stored hue / saturation / lightness steps (uint8_t is not a valid
+        // uniform_int_distribution type, so the 8-bit channels are drawn as int)
+        template <typename URBG> static HSL random(URBG &gen) {
             std::uniform_int_distribution<uint16_t> hue_dist(0, 35999);
-            std::uniform_int_distribution<uint8_t> sat_dist(0, 255);
-            std::uniform_int_distribution<uint8_t> light_dist(0, 255);
+            std::uniform_int_distribution<int> channel_dist(0, 255);
 
             HSL result;
             result.h = hue_dist(gen);
-            result.s = sat_dist(gen);
-            result.l = light_dist(gen);
+            result.s = static_cast<uint8_t>(channel_dist(gen));
+            result.l = static_cast<uint8_t>(channel_dist(gen));
             result.alpha = 255;
             return result;
         }
+
+        static HSL random() { return random(rng::engine()); }
     };
 
     // Implementation of RGB conversion constructor
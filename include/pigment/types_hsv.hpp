@@ -58,6 +58,7 @@ namespace pigment {
 
         // Create HSV from an RGB (alpha ignored)
         static HSV fromRGB(const RGB &c) {
+            PIGMENT_COUNT(HSV_FROM_RGB);
             float rf = c.r() / 255.0f;
             float gf = c.g() / 255.0f;
             float bf = c.b() / 255.0f;
@@ -91,6 +92,7 @@ namespace pigment {
 
         // Convert this HSV to RGB (alpha = 255)
         RGB to_rgb() const {
+            PIGMENT_COUNT(HSV_TO_RGB);
             float C = v() * s();
             float X = C * (1 - std::fabs(std::fmod(h() / 60.0f, 2.0f) - 1));
             float m = v() - C;
@@ -53,8 +53,19 @@ namespace pigment {
             return table;
         }
 
+        // Single-precision copy of the gamma table for the float (SIMD) kernels
+        constexpr std::array<float, GAMMA_TABLE_SIZE> create_gamma_to_linear_float_table() {
+            auto source = create_gamma_to_linear_table();
+            std::array<float, GAMMA_TABLE_SIZE> table{};
+            for (size_t i = 0; i < GAMMA_TABLE_SIZE; ++i) {
+                table[i] = static_cast<float>(source[i]);
+            }
+            return table;
+        }
+
         // Create the lookup tables
         static const auto gamma_to_linear = create_gamma_to_linear_table();
+        static const auto gamma_to_linear_f = create_gamma_to_linear_float_table();
         static const auto linear_to_gamma = create_linear_to_gamma_table();
         static const auto lab_f = create_lab_f_table();
         static const auto lab_f_inv = create_lab_f_inv_table();
@@ -79,8 +90,209 @@ namespace pigment {
             size_t index = static_cast<size_t>(t * (LAB_F_TABLE_SIZE - 1));
             return lab_f_inv[index];
         }
+
+        // Accuracy of the lookups used by LAB conversions:
+        //   LUT          - nearest-lower entry of the 4096-entry tables above (historical behaviour)
+        //   INTERPOLATED - linear interpolation between entries of an N-entry table
+        //   EXACT        - direct std::pow / std::cbrt evaluation
+        enum class Precision { LUT, INTERPOLATED, EXACT };
+
+        // Compile-time default for LAB::fromRGB / LAB::to_rgb, e.g. -DPIGMENT_LAB_PRECISION=INTERPOLATED
+#ifndef PIGMENT_LAB_PRECISION
+#define PIGMENT_LAB_PRECISION LUT
+#endif
+        constexpr Precision DEFAULT_PRECISION = Precision::PIGMENT_LAB_PRECISION;
+
+        // Reference functions
+        inline double exact_linear_to_gamma(double val) {
+            val = std::clamp(val, 0.0, 1.0);
+            return (val > 0.0031308) ? 1.055 * std::pow(val, 1.0 / 2.4) - 0.055 : 12.92 * val;
+        }
+
+        inline double exact_lab_f(double t) { return (t > 0.008856) ? std::cbrt(t) : (7.787 * t + 16.0 / 116.0); }
+
+        inline double exact_lab_f_inv(double t) {
+            double t3 = t * t * t;
+            return (t3 > 0.008856) ? t3 : (t - 16.0 / 116.0) / 7.787;
+        }
+
+        // N samples of `fn` over [0, range]
+        template <size_t N, typename Fn> std::array<double, N> sample_table(Fn fn, double range) {
+            static_assert(N >= 2, "Interpolated tables need at least two entries");
+            std::array<double, N> table{};
+            for (size_t i = 0; i < N; ++i) {
+                table[i] = fn(i / double(N - 1) * range);
+            }
+            return table;
+        }
+
+        template <size_t N> const std::array<double, N> &linear_to_gamma_table() {
+            if constexpr (N == LINEAR_TABLE_SIZE) {
+                return linear_to_gamma;
+            } else {
+                static const auto table = sample_table<N>(exact_linear_to_gamma, 1.0);
+                return table;
+            }
+        }
+
+        template <size_t N> const std::array<double, N> &lab_f_table() {
+            if constexpr (N == LAB_F_TABLE_SIZE) {
+                return lab_f;
+            } else {
+                static const auto table = sample_table<N>(exact_lab_f, 2.0);
+                return table;
+            }
+        }
+
+        template <size_t N> const std::array<double, N> &lab_f_inv_table() {
+            if constexpr (N == LAB_F_TABLE_SIZE) {
+                return lab_f_inv;
+            } else {
+                static const auto table = sample_table<N>(exact_lab_f_inv, 2.0);
+                return table;
+            }
+        }
+
+        // Linear interpolation in a table covering [0, range]; input clamped to the range
+        template <size_t N> inline double interpolate(const std::array<double, N> &table, double t, double range) {
+            double pos = std::clamp(t / range, 0.0, 1.0) * (N - 1);
+            size_t index = std::min(static_cast<size_t>(pos), N - 2);
+            double frac = pos - static_cast<double>(index);
+            return table[index] + (table[index + 1] - table[index]) * frac;
+        }
+
+        template <size_t N = LINEAR_TABLE_SIZE> inline double interpolated_linear_to_gamma(double val) {
+            return interpolate(linear_to_gamma_table<N>(), val, 1.0);
+        }
+
+        template <size_t N = LAB_F_TABLE_SIZE> inline double interpolated_lab_f(double t) {
+            return interpolate(lab_f_table<N>(), t, 2.0);
+        }
+
+        template <size_t N = LAB_F_TABLE_SIZE> inline double interpolated_lab_f_inv(double t) {
+            return interpolate(lab_f_inv_table<N>(), t, 2.0);
+        }
+
+        // Precision-selected lookups; N only applies to INTERPOLATED
+        template <Precision P, size_t N = LINEAR_TABLE_SIZE> inline double linear_to_gamma_at(double val) {
+            if constexpr (P == Precision::EXACT) {
+                return exact_linear_to_gamma(val);
+            } else if constexpr (P == Precision::INTERPOLATED) {
+                return interpolated_linear_to_gamma<N>(val);
+            } else {
+                return fast_linear_to_gamma(val);
+            }
+        }
+
+        template <Precision P, size_t N = LAB_F_TABLE_SIZE> inline double lab_f_at(double t) {
+            if constexpr (P == Precision::EXACT) {
+                return exact_lab_f(t);
+            } else if constexpr (P == Precision::INTERPOLATED) {
+                return interpolated_lab_f<N>(t);
+            } else {
+                return fast_lab_f(t);
+            }
+        }
+
+        template <Precision P, size_t N = LAB_F_TABLE_SIZE> inline double lab_f_inv_at(double t) {
+            if constexpr (P == Precision::EXACT) {
+                return exact_lab_f_inv(t);
+            } else if constexpr (P == Precision::INTERPOLATED) {
+                return interpolated_lab_f_inv<N>(t);
+            } else {
+                return fast_lab_f_inv(t);
+            }
+        }
     } // namespace lab_tables
 
+    namespace delta_e_detail {
+        // Weighted CIEDE2000 terms: lightness = dL'/(kL SL), chroma = dC'/(kC SC), hue = dH'/(kH SH) and the
+        // rotation factor RT, so that dE00^2 = lightness^2 + chroma^2 + hue^2 + RT * chroma * hue
+        struct Ciede2000Terms {
+            double lightness;
+            double chroma;
+            double hue;
+            double rotation;
+        };
+
+        constexpr double POW25_7 = 6103515625.0; // 25^7
+        constexpr double DEG_TO_RAD = M_PI / 180.0;
+
+        inline double pow7(double x) {
+            double x2 = x * x;
+            return x2 * x2 * x2 * x;
+        }
+
+        inline double ciede2000_lightness_term(double l1, double l2, double kL) {
+            double l_mean = (l1 + l2) * 0.5 - 50.0;
+            double sl = 1.0 + 0.015 * l_mean * l_mean / std::sqrt(20.0 + l_mean * l_mean);
+            return (l2 - l1) / (kL * sl);
+        }
+
+        inline Ciede2000Terms ciede2000_terms(double l1, double a1, double b1, double l2, double a2, double b2,
+                                              double kL, double kC, double kH) {
+            // a' rescaling (G factor) from the mean chroma
+            double c_mean = (std::sqrt(a1 * a1 + b1 * b1) + std::sqrt(a2 * a2 + b2 * b2)) * 0.5;
+            double c_mean7 = pow7(c_mean);
+            double g = 0.5 * (1.0 - std::sqrt(c_mean7 / (c_mean7 + POW25_7)));
+            double a1p = (1.0 + g) * a1;
+            double a2p = (1.0 + g) * a2;
+
+            double c1p = std::sqrt(a1p * a1p + b1 * b1);
+            double c2p = std::sqrt(a2p * a2p + b2 * b2);
+
+            // Hue angles in degrees, [0, 360); achromatic colors get hue 0
+            auto hue = [](double bb, double ap) {
+                if (bb == 0.0 && ap == 0.0) {
+                    return 0.0;
+                }
+                double h = std::atan2(bb, ap) / DEG_TO_RAD;
+                return h < 0.0 ? h + 360.0 : h;
+            };
+            double h1p = hue(b1, a1p);
+            double h2p = hue(b2, a2p);
+
+            double dcp = c2p - c1p;
+            double chroma_product = c1p * c2p;
+            double dhp = 0.0;
+            if (chroma_product != 0.0) {
+                dhp = h2p - h1p;
+                if (dhp > 180.0) {
+                    dhp -= 360.0;
+                } else if (dhp < -180.0) {
+                    dhp += 360.0;
+                }
+            }
+            double dHp = 2.0 * std::sqrt(chroma_product) * std::sin(dhp * 0.5 * DEG_TO_RAD);
+
+            double cp_mean = (c1p + c2p) * 0.5;
+            double hp_mean = h1p + h2p;
+            if (chroma_product != 0.0) {
+                if (std::abs(h1p - h2p) <= 180.0) {
+                    hp_mean *= 0.5;
+                } else if (hp_mean < 360.0) {
+                    hp_mean = (hp_mean + 360.0) * 0.5;
+                } else {
+                    hp_mean = (hp_mean - 360.0) * 0.5;
+                }
+            }
+
+            double t = 1.0 - 0.17 * std::cos((hp_mean - 30.0) * DEG_TO_RAD) +
+                       0.24 * std::cos(2.0 * hp_mean * DEG_TO_RAD) +
+                       0.32 * std::cos((3.0 * hp_mean + 6.0) * DEG_TO_RAD) -
+                       0.20 * std::cos((4.0 * hp_mean - 63.0) * DEG_TO_RAD);
+            double dtheta = 30.0 * std::exp(-((hp_mean - 275.0) / 25.0) * ((hp_mean - 275.0) / 25.0));
+            double cp_mean7 = pow7(cp_mean);
+            double rc = 2.0 * std::sqrt(cp_mean7 / (cp_mean7 + POW25_7));
+
+            double sc = 1.0 + 0.045 * cp_mean;
+            double sh = 1.0 + 0.015 * cp_mean * t;
+
+            return {ciede2000_lightness_term(l1, l2, kL), dcp / (kC * sc), dHp / (kH * sh),
+                    -std::sin(2.0 * dtheta * DEG_TO_RAD) * rc};
+        }
+    } // namespace delta_e_detail
+
     /**
      * @brief LAB color type built on datapod::mat::Vector<double, 4>
      *
@@ -115,8 +327,13 @@ namespace pigment {
             data_[3] = alpha_;
         }
 
-        // Convert from RGB using D65 illuminant (optimized with lookup tables)
+        // Convert from RGB using D65 illuminant at the compile-time default precision
+        static LAB fromRGB(const RGB &rgb) { return fromRGB<lab_tables::DEFAULT_PRECISION>(rgb); }
+
+        // Convert from RGB with an explicit lookup precision (table size N for INTERPOLATED)
+        template <lab_tables::Precision P, size_t N = lab_tables::LAB_F_TABLE_SIZE>
         static LAB fromRGB(const RGB &rgb) {
+            PIGMENT_COUNT(LAB_FROM_RGB);
             // Use lookup tables for gamma correction
             double r_val = lab_tables::fast_gamma_to_linear(rgb.r());
             double g_val = lab_tables::fast_gamma_to_linear(rgb.g());
@@ -132,10 +349,10 @@ namespace pigment {
             y /= 1.00000;
             z /= 1.08883;
 
-            // Convert XYZ to LAB using lookup tables
-            double fx = lab_tables::fast_lab_f(x);
-            double fy = lab_tables::fast_lab_f(y);
-            double fz = lab_tables::fast_lab_f(z);
+            // Convert XYZ to LAB
+            double fx = lab_tables::lab_f_at<P, N>(x);
+            double fy = lab_tables::lab_f_at<P, N>(y);
+            double fz = lab_tables::lab_f_at<P, N>(z);
 
             LAB lab;
             lab.data_[0] = 116.0 * fy - 16.0;
@@ -146,27 +363,31 @@ namespace pigment {
             return lab;
         }
 
-        // Convert to RGB (optimized with lookup tables)
-        RGB to_rgb() const {
+        // Convert to RGB at the compile-time default precision
+        RGB to_rgb() const { return to_rgb<lab_tables::DEFAULT_PRECISION>(); }
+
+        // Convert to RGB with an explicit lookup precision (table size N for INTERPOLATED)
+        template <lab_tables::Precision P, size_t N = lab_tables::LAB_F_TABLE_SIZE> RGB to_rgb() const {
+            PIGMENT_COUNT(LAB_TO_RGB);
             // Convert LAB to XYZ
             double fy = (l() + 16.0) / 116.0;
             double fx = a() / 500.0 + fy;
             double fz = fy - b() / 200.0;
 
-            // Use lookup tables for f inverse function
-            double x = lab_tables::fast_lab_f_inv(fx) * 0.95047;
-            double y = lab_tables::fast_lab_f_inv(fy) * 1.00000;
-            double z = lab_tables::fast_lab_f_inv(fz) * 1.08883;
+            // f inverse function
+            double x = lab_tables::lab_f_inv_at<P, N>(fx) * 0.95047;
+            double y = lab_tables::lab_f_inv_at<P, N>(fy) * 1.00000;
+            double z = lab_tables::lab_f_inv_at<P, N>(fz) * 1.08883;
 
             // Convert XYZ to RGB
             double r_val = x * 3.2404542 + y * -1.5371385 + z * -0.4985314;
             double g_val = x * -0.9692660 + y * 1.8760108 + z * 0.0415560;
             double b_val = x * 0.0556434 + y * -0.2040259 + z * 1.0572252;
 
-            // Apply inverse gamma correction using lookup tables
-            r_val = lab_tables::fast_linear_to_gamma(r_val);
-            g_val = lab_tables::fast_linear_to_gamma(g_val);
-            b_val = lab_tables::fast_linear_to_gamma(b_val);
+            // Apply inverse gamma correction
+            r_val = lab_tables::linear_to_gamma_at<P, N>(r_val);
+            g_val = lab_tables::linear_to_gamma_at<P, N>(g_val);
+            b_val = lab_tables::linear_to_gamma_at<P, N>(b_val);
 
             return RGB(std::clamp(static_cast<int>(std::round(r_val * 255)), 0, 255),
                        std::clamp(static_cast<int>(std::round(g_val * 255)), 0, 255),
@@ -181,9 +402,30 @@ namespace pigment {
             return std::sqrt(dl * dl + da * da + db * db);
         }
 
-        // More accurate Delta E 2000 calculation
-        double delta_e_2000(const LAB &other) const {
-            // Simplified implementation - full CIE Delta E 2000 is quite complex
+        // CIEDE2000 color difference (Sharma, Wu & Dalal 2005 formulation); kL, kC, kH are the parametric weights
+        double delta_e_2000(const LAB &other, double kL = 1.0, double kC = 1.0, double kH = 1.0) const {
+            auto t = delta_e_detail::ciede2000_terms(l(), a(), b(), other.l(), other.a(), other.b(), kL, kC, kH);
+            return std::sqrt(t.lightness * t.lightness + t.chroma * t.chroma + t.hue * t.hue +
+                             t.rotation * t.chroma * t.hue);
+        }
+
+        // True when CIEDE2000 < threshold. The C/H part of the sum is never negative (|RT| <= 2), so the
+        // lightness term alone rejects most distant pairs before any trigonometry runs.
+        bool is_within_2000(const LAB &other, double threshold, double kL = 1.0, double kC = 1.0,
+                            double kH = 1.0) const {
+            double limit = threshold * threshold;
+            double lightness = delta_e_detail::ciede2000_lightness_term(l(), other.l(), kL);
+            if (lightness * lightness >= limit) {
+                return false;
+            }
+            auto t = delta_e_detail::ciede2000_terms(l(), a(), b(), other.l(), other.a(), other.b(), kL, kC, kH);
+            return t.lightness * t.lightness + t.chroma * t.chroma + t.hue * t.hue + t.rotation * t.chroma * t.hue <
+                   limit;
+        }
+
+        // CIE94 color difference with this color as the reference (graphic arts weights by default; textiles use
+        // kL = 2, k1 = 0.048, k2 = 0.014)
+        double delta_e_94(const LAB &other, double kL = 1.0, double k1 = 0.045, double k2 = 0.015) const {
             double dl = l() - other.l();
             double da = a() - other.a();
             double db = b() - other.b();
@@ -192,13 +434,14 @@ namespace pigment {
             double c2 = std::sqrt(other.a() * other.a() + other.b() * other.b());
             double dc = c1 - c2;
 
-            double dh = std::sqrt(da * da + db * db - dc * dc);
+            // Clamp: rounding can push the hue difference slightly negative for near-identical hues
+            double dh_sq = std::max(0.0, da * da + db * db - dc * dc);
 
-            double sl = 1.0;
-            double sc = 1.0 + 0.045 * c1;
-            double sh = 1.0 + 0.015 * c1;
+            double sl = kL;
+            double sc = 1.0 + k1 * c1;
+            double sh = 1.0 + k2 * c1;
 
-            return std::sqrt((dl / sl) * (dl / sl) + (dc / sc) * (dc / sc) + (dh / sh) * (dh / sh));
+            return std::sqrt((dl / sl) * (dl / sl) + (dc / sc) * (dc / sc) + dh_sq / (sh * sh));
         }
 
         // Check if two colors are perceptually similar
@@ -71,6 +71,7 @@ namespace pigment {
 
         // Create LCH from RGB (via LAB conversion)
         static LCH fromRGB(const RGB &rgb) {
+            PIGMENT_COUNT(LCH_FROM_RGB);
             LAB lab = LAB::fromRGB(rgb);
             return fromLAB(lab);
         }
@@ -82,7 +83,10 @@ namespace pigment {
         }
 
         // Convert LCH to RGB (via LAB conversion)
-        RGB to_rgb() const { return to_lab().to_rgb(); }
+        RGB to_rgb() const {
+            PIGMENT_COUNT(LCH_TO_RGB);
+            return to_lab().to_rgb();
+        }
 
         // Equality operators
         bool operator==(const LCH &other) const {
@@ -1,12 +1,63 @@
 #pragma once
 
 #include "types_basic.hpp"
+#include "types_lab.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 
 namespace pigment {
 
+    namespace oklab_tables {
+        // Inverse gamma (linear -> sRGB) sampled uniformly in sqrt(linear): the curve is close to a straight
+        // line in that domain, so linear interpolation between 1024 samples stays far below 1/255.
+        constexpr size_t SQRT_GAMMA_TABLE_SIZE = 1024;
+        constexpr std::array<double, SQRT_GAMMA_TABLE_SIZE + 1> create_sqrt_linear_to_gamma_table() {
+            std::array<double, SQRT_GAMMA_TABLE_SIZE + 1> table{};
+            for (size_t i = 0; i <= SQRT_GAMMA_TABLE_SIZE; ++i) {
+                double u = i / double(SQRT_GAMMA_TABLE_SIZE);
+                double val = u * u;
+                table[i] = (val > 0.0031308) ? 1.055 * std::pow(val, 1.0 / 2.4) - 0.055 : 12.92 * val;
+            }
+            return table;
+        }
+
+        static const auto sqrt_linear_to_gamma = create_sqrt_linear_to_gamma_table();
+
+        // Interpolated inverse gamma; input clamped to [0, 1]
+        inline double fast_linear_to_gamma(double val) {
+            double pos = std::sqrt(std::clamp(val, 0.0, 1.0)) * SQRT_GAMMA_TABLE_SIZE;
+            size_t index = std::min(static_cast<size_t>(pos), SQRT_GAMMA_TABLE_SIZE - 1);
+            double t = pos - static_cast<double>(index);
+            return sqrt_linear_to_gamma[index] + (sqrt_linear_to_gamma[index + 1] - sqrt_linear_to_gamma[index]) * t;
+        }
+
+        // Cube root from an exponent-divided bit seed plus three Newton steps (relative error below 1e-9 for
+        // the positive LMS range; exact zero for zero input)
+        inline double fast_cbrt(double x) {
+            if (x <= 0.0) {
+                return x == 0.0 ? 0.0 : -fast_cbrt(-x);
+            }
+            uint64_t bits;
+            std::memcpy(&bits, &x, sizeof(bits));
+            bits = bits / 3 + 0x2A9F7893782DA1CEull;
+            double y;
+            std::memcpy(&y, &bits, sizeof(y));
+            for (int i = 0; i < 3; ++i) {
+                y = (2.0 * y + x / (y * y)) * (1.0 / 3.0);
+            }
+            return y;
+        }
+
+        // Documented bounds of the fast path against fromRGB / to_rgb over all 2^24 inputs, enforced by
+        // test/test_oklab.cpp. The measured worst case is 1.43e-12 (same with and without FMA).
+        constexpr double FAST_FROM_RGB_MAX_ERROR = 2e-12; // max |component difference|
+        constexpr int FAST_TO_RGB_MAX_CHANNEL_ERROR = 1;  // max 8-bit channel difference
+    } // namespace oklab_tables
+
     /**
      * @brief OKLAB color type built on datapod::mat::Vector<double, 3>
      *
@@ -37,31 +88,18 @@ namespace pigment {
             data_[2] = b_;
         }
 
-        // Create OKLAB from RGB using the improved Oklab color space
-        static OKLAB fromRGB(const RGB &c) {
-            // First convert RGB to linear RGB
-            auto linearize = [](double val) {
-                val = val / 255.0;
-                if (val <= 0.04045) {
-                    return val / 12.92;
-                } else {
-                    return std::pow((val + 0.055) / 1.055, 2.4);
-                }
-            };
-
-            double r_val = linearize(c.r());
-            double g_val = linearize(c.g());
-            double b_val = linearize(c.b());
-
+      private:
+        // Linear RGB -> OKLAB with a pluggable cube root
+        template <typename Cbrt> static OKLAB from_linear(double r_val, double g_val, double b_val, Cbrt cbrt) {
             // Convert linear RGB to LMS (cone response)
             double lms_l = 0.4122214708 * r_val + 0.5363325363 * g_val + 0.0514459929 * b_val;
             double lms_m = 0.2119034982 * r_val + 0.6806995451 * g_val + 0.1073969566 * b_val;
             double lms_s = 0.0883024619 * r_val + 0.2817188376 * g_val + 0.6299787005 * b_val;
 
             // Apply cube root
-            lms_l = std::cbrt(lms_l);
-            lms_m = std::cbrt(lms_m);
-            lms_s = std::cbrt(lms_s);
+            lms_l = cbrt(lms_l);
+            lms_m = cbrt(lms_m);
+            lms_s = cbrt(lms_s);
 
             // Convert to Oklab
             OKLAB result;
@@ -72,8 +110,8 @@ namespace pigment {
             return result;
         }
 
-        // Convert OKLAB to RGB
-        RGB to_rgb() const {
+        // OKLAB -> linear RGB
+        void to_linear(double &r_linear, double &g_linear, double &b_linear) const {
             // Convert Oklab to LMS
             double lms_l = l() + 0.3963377774 * a() + 0.2158037573 * b();
             double lms_m = l() - 0.1055613458 * a() - 0.0638541728 * b();
@@ -85,9 +123,35 @@ namespace pigment {
             lms_s = lms_s * lms_s * lms_s;
 
             // Convert LMS to linear RGB
-            double r_linear = +4.0767416621 * lms_l - 3.3077115913 * lms_m + 0.2309699292 * lms_s;
-            double g_linear = -1.2684380046 * lms_l + 2.6097574011 * lms_m - 0.3413193965 * lms_s;
-            double b_linear = -0.0041960863 * lms_l - 0.7034186147 * lms_m + 1.7076147010 * lms_s;
+            r_linear = +4.0767416621 * lms_l - 3.3077115913 * lms_m + 0.2309699292 * lms_s;
+            g_linear = -1.2684380046 * lms_l + 2.6097574011 * lms_m - 0.3413193965 * lms_s;
+            b_linear = -0.0041960863 * lms_l - 0.7034186147 * lms_m + 1.7076147010 * lms_s;
+        }
+
+        static uint8_t to_byte(double val) {
+            return static_cast<uint8_t>(std::clamp(std::round(val * 255.0), 0.0, 255.0));
+        }
+
+      public:
+        // Create OKLAB from RGB using the improved Oklab color space (linearized via the shared gamma table)
+        static OKLAB fromRGB(const RGB &c) {
+            PIGMENT_COUNT(OKLAB_FROM_RGB);
+            return from_linear(lab_tables::gamma_to_linear[c.r()], lab_tables::gamma_to_linear[c.g()],
+                               lab_tables::gamma_to_linear[c.b()], [](double v) { return std::cbrt(v); });
+        }
+
+        // Fast variant: Newton cube root instead of std::cbrt (see oklab_tables::FAST_FROM_RGB_MAX_ERROR)
+        static OKLAB fromRGB_fast(const RGB &c) {
+            PIGMENT_COUNT(OKLAB_FROM_RGB_FAST);
+            return from_linear(lab_tables::gamma_to_linear[c.r()], lab_tables::gamma_to_linear[c.g()],
+                               lab_tables::gamma_to_linear[c.b()], oklab_tables::fast_cbrt);
+        }
+
+        // Convert OKLAB to RGB
+        RGB to_rgb() const {
+            PIGMENT_COUNT(OKLAB_TO_RGB);
+            double r_linear, g_linear, b_linear;
+            to_linear(r_linear, g_linear, b_linear);
 
             // Apply gamma correction
             auto gamma_correct = [](double val) {
@@ -103,9 +167,17 @@ namespace pigment {
             double b_val = gamma_correct(b_linear);
 
             // Convert to 0-255 range and clamp
-            return RGB(static_cast<uint8_t>(std::clamp(std::round(r_val * 255.0), 0.0, 255.0)),
-                       static_cast<uint8_t>(std::clamp(std::round(g_val * 255.0), 0.0, 255.0)),
-                       static_cast<uint8_t>(std::clamp(std::round(b_val * 255.0), 0.0, 255.0)), 255);
+            return RGB(to_byte(r_val), to_byte(g_val), to_byte(b_val), 255);
+        }
+
+        // Fast variant: interpolated inverse gamma table instead of std::pow
+        // (see oklab_tables::FAST_TO_RGB_MAX_CHANNEL_ERROR)
+        RGB to_rgb_fast() const {
+            double r_linear, g_linear, b_linear;
+            to_linear(r_linear, g_linear, b_linear);
+            return RGB(to_byte(oklab_tables::fast_linear_to_gamma(r_linear)),
+                       to_byte(oklab_tables::fast_linear_to_gamma(g_linear)),
+                       to_byte(oklab_tables::fast_linear_to_gamma(b_linear)), 255);
         }
 
         // Equality operators
@@ -39,6 +39,7 @@ namespace pigment {
 
         // Create XYZ from RGB (using sRGB color space with D65 illuminant)
         static XYZ fromRGB(const RGB &c) {
+            PIGMENT_COUNT(XYZ_FROM_RGB);
             // Convert RGB to linear RGB
             auto linearize = [](double val) {
                 val = val / 255.0;
@@ -69,6 +70,7 @@ namespace pigment {
 
         // Convert XYZ to RGB
         RGB to_rgb() const {
+            PIGMENT_COUNT(XYZ_TO_RGB);
             // Normalize to 0-1 range
             double x_val = x() / 95.047;
             double y_val = y() / 100.0;
@@ -1,17 +1,34 @@
 #pragma once
 
+#include "conversion_cache.hpp"
+#include "histogram.hpp"
+#include "palette_index.hpp"
+#include "parallel.hpp"
 #include "types_basic.hpp"
 #include "types_hsl.hpp"
 #include "types_lab.hpp"
+#include "types_oklab.hpp"
 
 #include <algorithm>
+#include <array>
+#include <bit>
 #include <cmath>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace pigment {
     namespace utils {
 
-        // Color blindness simulation
+        // Color blindness simulation (single pixel, gamma space). ColorVision in color_vision.hpp applies the
+        // linear-light Machado model to whole images.
         struct ColorBlindness {
             enum Type {
                 PROTANOPIA,    // Red blind
@@ -131,121 +148,242 @@ namespace pigment {
             return color_temperature(color) < 5000; // Below daylight temperature
         }
 
+        // The generate_* helpers also write through an output iterator (returning it past the last color) or
+        // fill a caller-owned span, so palettes can be built into reused buffers without allocating.
+
         // Generate monochromatic color variations
-        inline std::vector<RGB> generate_monochromatic(const RGB &base, int count = 5) {
+        template <std::output_iterator<RGB> OutputIt>
+        OutputIt generate_monochromatic(const RGB &base, int count, OutputIt out) {
             HSL hsl = HSL::fromRGB(base);
-            std::vector<RGB> colors;
-            colors.reserve(count);
 
             // Generate variations by adjusting lightness and saturation
             for (int i = 0; i < count; ++i) {
-
-                // Create variations with different lightness levels
-                HSL variation = hsl;
                 if (i == count / 2) {
                     // Keep original color in the middle
-                    colors.push_back(base);
+                    *out++ = base;
                 } else if (i < count / 2) {
                     // Darker variations
-                    variation = hsl.darken(0.1 * (count / 2 - i));
+                    *out++ = hsl.darken(0.1 * (count / 2 - i)).to_rgb();
                 } else {
                     // Lighter variations
-                    variation = hsl.lighten(0.1 * (i - count / 2));
-                }
-
-                if (i != count / 2) {
-                    colors.push_back(variation.to_rgb());
+                    *out++ = hsl.lighten(0.1 * (i - count / 2)).to_rgb();
                 }
             }
+            return out;
+        }
+
+        inline void generate_monochromatic(const RGB &base, std::span<RGB> out) {
+            generate_monochromatic(base, static_cast<int>(out.size()), out.begin());
+        }
 
+        inline std::vector<RGB> generate_monochromatic(const RGB &base, int count = 5) {
+            std::vector<RGB> colors;
+            colors.reserve(std::max(count, 0));
+            generate_monochromatic(base, count, std::back_inserter(colors));
             return colors;
         }
 
-        // Generate enhanced split-complementary with custom angles
-        inline std::vector<RGB> generate_split_complementary(const RGB &base, double angle = 30.0) {
+        // Generate enhanced split-complementary with custom angles (3 colors)
+        template <std::output_iterator<RGB> OutputIt>
+        OutputIt generate_split_complementary(const RGB &base, double angle, OutputIt out) {
             HSL hsl = HSL::fromRGB(base);
-            std::vector<RGB> colors = {base};
+            *out++ = base;
 
             // Generate split-complementary with custom angle
-            colors.push_back(hsl.adjust_hue(180.0 - angle).to_rgb());
-            colors.push_back(hsl.adjust_hue(180.0 + angle).to_rgb());
+            *out++ = hsl.adjust_hue(180.0 - angle).to_rgb();
+            *out++ = hsl.adjust_hue(180.0 + angle).to_rgb();
+            return out;
+        }
 
+        inline std::vector<RGB> generate_split_complementary(const RGB &base, double angle = 30.0) {
+            std::vector<RGB> colors;
+            colors.reserve(3);
+            generate_split_complementary(base, angle, std::back_inserter(colors));
             return colors;
         }
 
         // Generate colors based on golden ratio (137.5 deg)
-        inline std::vector<RGB> generate_golden_ratio_scheme(const RGB &base, int count = 5) {
+        template <std::output_iterator<RGB> OutputIt>
+        OutputIt generate_golden_ratio_scheme(const RGB &base, int count, OutputIt out) {
             constexpr double GOLDEN_ANGLE = 137.507764050; // Golden angle in degrees
             HSL hsl = HSL::fromRGB(base);
-            std::vector<RGB> colors = {base};
+            *out++ = base;
 
             for (int i = 1; i < count; ++i) {
-                HSL variation = hsl.adjust_hue(GOLDEN_ANGLE * i);
-                colors.push_back(variation.to_rgb());
+                *out++ = hsl.adjust_hue(GOLDEN_ANGLE * i).to_rgb();
             }
+            return out;
+        }
+
+        inline void generate_golden_ratio_scheme(const RGB &base, std::span<RGB> out) {
+            if (!out.empty()) {
+                generate_golden_ratio_scheme(base, static_cast<int>(out.size()), out.begin());
+            }
+        }
 
+        inline std::vector<RGB> generate_golden_ratio_scheme(const RGB &base, int count = 5) {
+            std::vector<RGB> colors;
+            colors.reserve(std::max(count, 1));
+            generate_golden_ratio_scheme(base, count, std::back_inserter(colors));
             return colors;
         }
 
-        // Generate a harmonious color scheme
-        inline std::vector<RGB> generate_harmony(const RGB &base, const std::string &scheme = "complementary") {
+        // Generate a harmonious color scheme (at most 5 colors; unknown schemes yield just `base`)
+        template <std::output_iterator<RGB> OutputIt>
+        OutputIt generate_harmony(const RGB &base, std::string_view scheme, OutputIt out) {
+            if (scheme == "monochromatic") {
+                return generate_monochromatic(base, 5, out);
+            } else if (scheme == "golden_ratio") {
+                return generate_golden_ratio_scheme(base, 5, out);
+            }
+
             HSL hsl = HSL::fromRGB(base);
-            std::vector<RGB> colors = {base};
+            *out++ = base;
+            auto rotations = [&](std::initializer_list<double> degrees) {
+                for (double d : degrees) {
+                    *out++ = hsl.adjust_hue(d).to_rgb();
+                }
+            };
 
+            // Same colors as HSL::triadic / split_complementary / analogous, minus the base
             if (scheme == "complementary") {
-                colors.push_back(hsl.complement().to_rgb());
+                rotations({180.0});
             } else if (scheme == "triadic") {
-                auto triadic = hsl.triadic();
-                for (size_t i = 1; i < triadic.size(); ++i) {
-                    colors.push_back(triadic[i].to_rgb());
-                }
+                rotations({120.0, 240.0});
             } else if (scheme == "split_complementary") {
-                auto split = hsl.split_complementary();
-                for (size_t i = 1; i < split.size(); ++i) {
-                    colors.push_back(split[i].to_rgb());
-                }
+                rotations({150.0, 210.0});
             } else if (scheme == "analogous") {
-                auto analogous = hsl.analogous();
-                for (size_t i = 0; i < analogous.size(); ++i) {
-                    if (i != 1) { // Skip the base color (middle one)
-                        colors.push_back(analogous[i].to_rgb());
-                    }
-                }
+                rotations({-30.0, 30.0});
             } else if (scheme == "tetradic") {
-                colors.push_back(hsl.adjust_hue(90).to_rgb());
-                colors.push_back(hsl.adjust_hue(180).to_rgb());
-                colors.push_back(hsl.adjust_hue(270).to_rgb());
-            } else if (scheme == "monochromatic") {
-                return generate_monochromatic(base, 5);
-            } else if (scheme == "golden_ratio") {
-                return generate_golden_ratio_scheme(base, 5);
+                rotations({90.0, 180.0, 270.0});
             }
+            return out;
+        }
 
+        inline std::vector<RGB> generate_harmony(const RGB &base, const std::string &scheme = "complementary") {
+            std::vector<RGB> colors;
+            colors.reserve(5);
+            generate_harmony(base, std::string_view(scheme), std::back_inserter(colors));
             return colors;
         }
 
-        // Color sorting functions
-        inline void sort_by_hue(std::vector<RGB> &colors) {
-            std::sort(colors.begin(), colors.end(), [](const RGB &a, const RGB &b) {
-                HSL hsl_a = HSL::fromRGB(a);
-                HSL hsl_b = HSL::fromRGB(b);
-                return hsl_a.h < hsl_b.h;
-            });
+        namespace sort_detail {
+            struct Keyed {
+                uint32_t key;
+                RGB color;
+            };
+
+            // Order-preserving integer key for a non-negative float; negatives and NaN sort first
+            inline uint32_t float_key(float v) { return v > 0.0f ? std::bit_cast<uint32_t>(v) : 0u; }
+
+            // Stable LSD radix sort on 8-bit digits. Digits that are the same in every key are skipped, so
+            // 8-bit keys take one pass and the 16-bit HSL hue two.
+            inline void radix_sort(std::vector<Keyed> &items) {
+                if (items.size() < 64) {
+                    std::stable_sort(items.begin(), items.end(),
+                                     [](const Keyed &a, const Keyed &b) { return a.key < b.key; });
+                    return;
+                }
+
+                uint32_t any_set = 0, all_set = ~0u;
+                for (const Keyed &item : items) {
+                    any_set |= item.key;
+                    all_set &= item.key;
+                }
+
+                std::vector<Keyed> scratch(items.size());
+                for (int shift = 0; shift < 32; shift += 8) {
+                    if ((((any_set ^ all_set) >> shift) & 0xFF) == 0) {
+                        continue;
+                    }
+                    std::array<size_t, 256> offsets{};
+                    for (const Keyed &item : items) {
+                        ++offsets[(item.key >> shift) & 0xFF];
+                    }
+                    size_t total = 0;
+                    for (size_t &offset : offsets) {
+                        size_t count = offset;
+                        offset = total;
+                        total += count;
+                    }
+                    for (const Keyed &item : items) {
+                        scratch[offsets[(item.key >> shift) & 0xFF]++] = item;
+                    }
+                    items.swap(scratch);
+                }
+            }
+
+            // Extracts every key once (tiled over the executor), radix-sorts, and writes the colors back
+            template <typename KeyFn, typename Executor>
+            void sort_by_key(std::span<RGB> colors, KeyFn key, Executor &executor) {
+                std::vector<Keyed> items(colors.size());
+                parallel::for_each_tile(colors.size(), executor, [&](size_t begin, size_t end) {
+                    for (size_t i = begin; i < end; ++i) {
+                        items[i] = {key(colors[i]), colors[i]};
+                    }
+                });
+                radix_sort(items);
+                for (size_t i = 0; i < items.size(); ++i) {
+                    colors[i] = items[i].color;
+                }
+            }
+
+            inline uint32_t hue_key(const RGB &c) { return HSL::fromRGB(c).h; }
+            inline uint32_t saturation_key(const RGB &c) { return HSL::fromRGB(c).s; }
+            // 1000x the luminance() weights, so the order is exact without floating point
+            inline uint32_t brightness_key(const RGB &c) { return 299u * c.r() + 587u * c.g() + 114u * c.b(); }
+            inline uint32_t lightness_key(const RGB &c) {
+                return float_key(static_cast<float>(OKLAB::fromRGB_fast(c).l()));
+            }
+            inline uint32_t oklch_hue_key(const RGB &c) {
+                return float_key(static_cast<float>(OKLAB::fromRGB_fast(c).hue_degrees()));
+            }
+        } // namespace sort_detail
+
+        // Color sorting functions. Each key is computed once per color and the colors are radix-sorted on it;
+        // the sorts are stable, so equal keys keep their input order. The executor overloads extract the keys
+        // in parallel.
+        template <typename Executor> void sort_by_hue(std::span<RGB> colors, Executor &&executor) {
+            PIGMENT_SCOPE_N("sort_by_hue", colors.size());
+            sort_detail::sort_by_key(colors, sort_detail::hue_key, executor);
         }
 
-        inline void sort_by_brightness(std::vector<RGB> &colors) {
-            std::sort(colors.begin(), colors.end(),
-                      [](const RGB &a, const RGB &b) { return a.luminance() < b.luminance(); });
+        template <typename Executor> void sort_by_brightness(std::span<RGB> colors, Executor &&executor) {
+            PIGMENT_SCOPE_N("sort_by_brightness", colors.size());
+            sort_detail::sort_by_key(colors, sort_detail::brightness_key, executor);
         }
 
-        inline void sort_by_saturation(std::vector<RGB> &colors) {
-            std::sort(colors.begin(), colors.end(), [](const RGB &a, const RGB &b) {
-                HSL hsl_a = HSL::fromRGB(a);
-                HSL hsl_b = HSL::fromRGB(b);
-                return hsl_a.s < hsl_b.s;
-            });
+        template <typename Executor> void sort_by_saturation(std::span<RGB> colors, Executor &&executor) {
+            PIGMENT_SCOPE_N("sort_by_saturation", colors.size());
+            sort_detail::sort_by_key(colors, sort_detail::saturation_key, executor);
+        }
+
+        // Perceptual lightness (OKLAB L)
+        template <typename Executor> void sort_by_lightness(std::span<RGB> colors, Executor &&executor) {
+            PIGMENT_SCOPE_N("sort_by_lightness", colors.size());
+            sort_detail::sort_by_key(colors, sort_detail::lightness_key, executor);
+        }
+
+        // OKLCH hue angle; achromatic colors have no meaningful hue and land wherever atan2 puts them
+        template <typename Executor> void sort_by_oklch_hue(std::span<RGB> colors, Executor &&executor) {
+            PIGMENT_SCOPE_N("sort_by_oklch_hue", colors.size());
+            sort_detail::sort_by_key(colors, sort_detail::oklch_hue_key, executor);
+        }
+
+        inline void sort_by_hue(std::span<RGB> colors) { sort_by_hue(colors, parallel::SerialExecutor{}); }
+
+        inline void sort_by_brightness(std::span<RGB> colors) {
+            sort_by_brightness(colors, parallel::SerialExecutor{});
+        }
+
+        inline void sort_by_saturation(std::span<RGB> colors) {
+            sort_by_saturation(colors, parallel::SerialExecutor{});
         }
 
+        inline void sort_by_lightness(std::span<RGB> colors) { sort_by_lightness(colors, parallel::SerialExecutor{}); }
+
+        inline void sort_by_oklch_hue(std::span<RGB> colors) { sort_by_oklch_hue(colors, parallel::SerialExecutor{}); }
+
         // Color distance calculation (LAB-based perceptual distance)
         inline double color_distance(const RGB &color1, const RGB &color2) {
             LAB lab1 = LAB::fromRGB(color1);
@@ -253,6 +391,11 @@ namespace pigment {
             return lab1.delta_e(lab2);
         }
 
+        // Same as above with both conversions served from a cache
+        inline double color_distance(const RGB &color1, const RGB &color2, const ConversionCache<LAB> &cache) {
+            return cache.get(color1).delta_e(cache.get(color2));
+        }
+
         // Simple RGB Euclidean distance
         inline double rgb_distance(const RGB &color1, const RGB &color2) {
             double dr = color1.r() - color2.r();
@@ -307,6 +450,7 @@ namespace pigment {
 
         // Find the closest color in a palette
         inline RGB find_closest_color(const RGB &target, const std::vector<RGB> &palette) {
+            PIGMENT_SCOPE_N("find_closest_color", palette.size());
             if (palette.empty())
                 return target;
 
@@ -324,18 +468,69 @@ namespace pigment {
             return closest;
         }
 
-        // Quantize colors to a palette
-        inline std::vector<RGB> quantize_to_palette(const std::vector<RGB> &colors, const std::vector<RGB> &palette) {
-            std::vector<RGB> quantized;
-            quantized.reserve(colors.size());
+        // Same as above with the LAB conversions served from a cache; the target is converted once
+        inline RGB find_closest_color(const RGB &target, const std::vector<RGB> &palette,
+                                      const ConversionCache<LAB> &cache) {
+            PIGMENT_SCOPE_N("find_closest_color", palette.size());
+            if (palette.empty())
+                return target;
 
-            for (const auto &color : colors) {
-                quantized.push_back(find_closest_color(color, palette));
+            const LAB &target_lab = cache.get(target);
+            RGB closest = palette[0];
+            double min_distance = target_lab.delta_e(cache.get(closest));
+
+            for (const auto &color : palette) {
+                double distance = target_lab.delta_e(cache.get(color));
+                if (distance < min_distance) {
+                    min_distance = distance;
+                    closest = color;
+                }
             }
 
+            return closest;
+        }
+
+        // Quantize colors to a palette
+        inline std::vector<RGB> quantize_to_palette(const std::vector<RGB> &colors, const std::vector<RGB> &palette) {
+            if (palette.empty())
+                return colors;
+
+            // Same answers as find_closest_color per color, with the palette converted and indexed once
+            std::vector<RGB> quantized(colors.size());
+            PaletteIndex(palette).quantize(colors, quantized);
             return quantized;
         }
 
+        // Parallel quantization into a preallocated span: the input is split into tiles that `executor` runs
+        // (threads by default); each tile queries the shared index and writes its slice of `out` in place
+        template <typename Executor = parallel::ThreadExecutor>
+        inline void quantize_to_palette(std::span<const RGB> colors, const PaletteIndex &index, std::span<RGB> out,
+                                        Executor &&executor = Executor{},
+                                        size_t tile_size = parallel::DEFAULT_TILE_SIZE) {
+            if (out.size() < colors.size()) {
+                throw std::invalid_argument("Destination span is smaller than source span");
+            }
+            parallel::for_each_tile(
+                colors.size(), executor,
+                [&](size_t begin, size_t end) {
+                    index.quantize(colors.subspan(begin, end - begin), out.subspan(begin, end - begin));
+                },
+                tile_size);
+        }
+
+        template <typename Executor = parallel::ThreadExecutor>
+        inline void quantize_to_palette(std::span<const RGB> colors, const std::vector<RGB> &palette,
+                                        std::span<RGB> out, Executor &&executor = Executor{}) {
+            if (palette.empty()) {
+                if (out.size() < colors.size()) {
+                    throw std::invalid_argument("Destination span is smaller than source span");
+                }
+                std::copy(colors.begin(), colors.end(), out.begin());
+                return;
+            }
+            quantize_to_palette(colors, PaletteIndex(palette), out, std::forward<Executor>(executor));
+        }
+
         // Color validation functions
         inline bool is_valid_rgb(int r, int g, int b, int a = 255) {
             return r >= 0 && r <= 255 && g >= 0 && g <= 255 && b >= 0 && b <= 255 && a >= 0 && a <= 255;
@@ -354,24 +549,7 @@ namespace pigment {
         }
 
         // String validation functions
-        inline bool is_valid_hex_color(const std::string &hex) {
-            if (hex.empty())
-                return false;
-
-            std::string h = hex;
-            if (h[0] == '#')
-                h.erase(0, 1);
-
-            if (h.size() != 3 && h.size() != 6 && h.size() != 8)
-                return false;
-
-            for (char c : h) {
-                if (!std::isxdigit(c))
-                    return false;
-            }
-
-            return true;
-        }
+        inline bool is_valid_hex_color(std::string_view hex) { return RGB::parse_hex(hex).has_value(); }
 
         inline bool is_valid_css_rgb(const std::string &css) {
             if (css.empty())
@@ -476,62 +654,148 @@ namespace pigment {
             return RGB(sepia_r, sepia_g, sepia_b, color.a());
         }
 
-        // Remove duplicate colors from palette
-        inline std::vector<RGB> remove_duplicates(const std::vector<RGB> &palette, double threshold = 5.0) {
-            std::vector<RGB> unique_colors;
+        namespace dedupe_detail {
+            // Keeps the first color of every group closer than `threshold`, in input order. Kept colors are
+            // bucketed in a grid of `threshold`-sized cells, so only the 27 cells around a candidate can hold a
+            // color within range; the exact distance test is the same one the quadratic scan applied.
+            template <typename ToPoint>
+            std::vector<RGB> grid_dedupe(const std::vector<RGB> &palette, double threshold, ToPoint to_point) {
+                if (!(threshold > 0.0)) {
+                    return palette; // distance < threshold never holds
+                }
 
-            for (const auto &color : palette) {
-                bool is_duplicate = false;
-                for (const auto &unique : unique_colors) {
-                    if (rgb_distance(color, unique) < threshold) {
-                        is_duplicate = true;
-                        break;
+                using Point = std::array<double, 3>;
+                auto cell_key = [](int64_t x, int64_t y, int64_t z) {
+                    // Collisions only merge buckets; membership is always decided by the exact distance
+                    return (static_cast<uint64_t>(x) * 0x9E3779B97F4A7C15ull) ^
+                           (static_cast<uint64_t>(y) * 0xC2B2AE3D27D4EB4Full) ^
+                           (static_cast<uint64_t>(z) * 0x165667B19E3779F9ull);
+                };
+
+                std::vector<RGB> unique_colors;
+                std::vector<Point> unique_points;
+                std::unordered_map<uint64_t, std::vector<uint32_t>> grid;
+
+                for (const auto &color : palette) {
+                    Point p = to_point(color);
+                    int64_t cell[3];
+                    for (int c = 0; c < 3; ++c) {
+                        cell[c] = static_cast<int64_t>(std::clamp(std::floor(p[c] / threshold), -4e18, 4e18));
+                    }
+
+                    bool is_duplicate = false;
+                    for (int64_t dx = -1; dx <= 1 && !is_duplicate; ++dx) {
+                        for (int64_t dy = -1; dy <= 1 && !is_duplicate; ++dy) {
+                            for (int64_t dz = -1; dz <= 1 && !is_duplicate; ++dz) {
+                                auto it = grid.find(cell_key(cell[0] + dx, cell[1] + dy, cell[2] + dz));
+                                if (it == grid.end()) {
+                                    continue;
+                                }
+                                for (uint32_t index : it->second) {
+                                    const Point &q = unique_points[index];
+                                    double d0 = p[0] - q[0], d1 = p[1] - q[1], d2 = p[2] - q[2];
+                                    if (std::sqrt(d0 * d0 + d1 * d1 + d2 * d2) < threshold) {
+                                        is_duplicate = true;
+                                        break;
+                                    }
+                                }
+                            }
+                        }
+                    }
+
+                    if (!is_duplicate) {
+                        grid[cell_key(cell[0], cell[1], cell[2])].push_back(
+                            static_cast<uint32_t>(unique_colors.size()));
+                        unique_colors.push_back(color);
+                        unique_points.push_back(p);
                     }
                 }
-                if (!is_duplicate) {
-                    unique_colors.push_back(color);
+
+                return unique_colors;
+            }
+        } // namespace dedupe_detail
+
+        // Remove colors closer than `threshold` (RGB Euclidean distance) to an earlier kept color
+        inline std::vector<RGB> remove_duplicates(const std::vector<RGB> &palette, double threshold = 5.0) {
+            PIGMENT_SCOPE_N("remove_duplicates", palette.size());
+            return dedupe_detail::grid_dedupe(palette, threshold, [](const RGB &c) {
+                return std::array<double, 3>{double(c.r()), double(c.g()), double(c.b())};
+            });
+        }
+
+        // Same with the threshold in LAB delta E (CIE76), i.e. perceptual duplicates
+        inline std::vector<RGB> remove_duplicates_lab(const std::vector<RGB> &palette, double threshold = 2.3) {
+            PIGMENT_SCOPE_N("remove_duplicates_lab", palette.size());
+            return dedupe_detail::grid_dedupe(palette, threshold, [](const RGB &c) {
+                LAB lab = LAB::fromRGB(c);
+                return std::array<double, 3>{lab.l(), lab.a(), lab.b()};
+            });
+        }
+
+        namespace dedupe_detail {
+            // Bin means, most populous first, so the bigger of two near-duplicate groups is the one kept
+            inline std::vector<RGB> by_population(const Histogram &histogram) {
+                std::vector<RGB> colors;
+                for (const Histogram::Bin &bin : histogram.top(histogram.occupied())) {
+                    colors.push_back(bin.mean());
                 }
+                return colors;
             }
+        } // namespace dedupe_detail
 
-            return unique_colors;
+        // Histogram variants: one candidate per occupied bin instead of one per pixel
+        inline std::vector<RGB> remove_duplicates(const Histogram &histogram, double threshold = 5.0) {
+            return remove_duplicates(dedupe_detail::by_population(histogram), threshold);
         }
 
-        // Extract dominant colors from a color array (simple approach)
+        inline std::vector<RGB> remove_duplicates_lab(const Histogram &histogram, double threshold = 2.3) {
+            return remove_duplicates_lab(dedupe_detail::by_population(histogram), threshold);
+        }
+
+        // Extract dominant colors from a color array (simple approach: farthest-point selection in RGB).
+        // Each round only measures against the newly selected color, so the cost is O(N * count).
+        // For large inputs prefer dominant::median_cut or dominant::kmeans.
         inline std::vector<RGB> extract_dominant_colors(const std::vector<RGB> &colors, int count = 5) {
+            PIGMENT_SCOPE_N("extract_dominant_colors", colors.size());
             if (colors.empty())
                 return {};
 
-            // Simple approach: cluster colors by similarity and pick representatives
             std::vector<RGB> dominant;
-            std::vector<RGB> remaining = colors;
+            std::vector<double> min_distance(colors.size(), std::numeric_limits<double>::max());
+            std::vector<bool> selected(colors.size(), false);
 
-            while (dominant.size() < static_cast<size_t>(count) && !remaining.empty()) {
-                // Find the color that's most different from already selected colors
-                RGB best_color = remaining[0];
+            while (dominant.size() < static_cast<size_t>(count) && dominant.size() < colors.size()) {
+                // Find the color that's most different from already selected colors (first one on ties)
+                size_t best_index = colors.size();
                 double best_distance = 0.0;
-                size_t best_index = 0;
 
-                for (size_t i = 0; i < remaining.size(); ++i) {
-                    double min_distance = std::numeric_limits<double>::max();
-
-                    for (const auto &selected : dominant) {
-                        double dist = rgb_distance(remaining[i], selected);
-                        min_distance = std::min(min_distance, dist);
+                for (size_t i = 0; i < colors.size(); ++i) {
+                    if (selected[i])
+                        continue;
+                    if (!dominant.empty()) {
+                        min_distance[i] = std::min(min_distance[i], rgb_distance(colors[i], dominant.back()));
                     }
-
-                    if (min_distance > best_distance) {
-                        best_distance = min_distance;
-                        best_color = remaining[i];
+                    if (best_index == colors.size()) {
+                        best_index = i;
+                    }
+                    if (min_distance[i] > best_distance) {
+                        best_distance = min_distance[i];
                         best_index = i;
                     }
                 }
 
-                dominant.push_back(best_color);
-                remaining.erase(remaining.begin() + best_index);
+                dominant.push_back(colors[best_index]);
+                selected[best_index] = true;
             }
 
             return dominant;
         }
 
+        // Same selection over the bin means of a histogram, starting from the most populous bin, so the cost is
+        // O(occupied bins * count) whatever the pixel count
+        inline std::vector<RGB> extract_dominant_colors(const Histogram &histogram, int count = 5) {
+            return extract_dominant_colors(dedupe_detail::by_population(histogram), count);
+        }
+
     } // namespace utils
 } // namespace pigment
@@ -0,0 +1,45 @@
+#include <doctest/doctest.h>
+
+#include <pigment/pigment.hpp>
+
+#include <stdexcept>
+#include <vector>
+
+using namespace pigment;
+
+TEST_CASE("empty colormap refuses every lookup") {
+    const Colormap empty;
+    REQUIRE(empty.empty());
+    CHECK_THROWS_AS(empty.sample(0.5), std::invalid_argument);
+    CHECK_THROWS_AS(empty(0.0), std::invalid_argument);
+
+    const std::vector<float> values = {0.0f, 1.0f};
+    std::vector<RGB> out(values.size());
+    CHECK_THROWS_AS(empty.map(values, out), std::invalid_argument);
+    CHECK_THROWS_AS(empty.map(std::span<const float>(values), std::span<RGB>(out), 0.0f, 1.0f,
+                              parallel::SerialExecutor{}),
+                    std::invalid_argument);
+}
+
+TEST_CASE("sample clamps to the end stops") {
+    const std::vector<RGB> stops = {RGB(0, 0, 0), RGB(255, 255, 255)};
+    const Colormap map(stops, Colormap::SMALL, Colormap::Space::RGB);
+    CHECK(map.sample(-1.0) == RGB(0, 0, 0));
+    CHECK(map.sample(0.0) == RGB(0, 0, 0));
+    CHECK(map.sample(1.0) == RGB(255, 255, 255));
+    CHECK(map(2.0) == RGB(255, 255, 255));
+}
+
+TEST_CASE("map agrees with sample") {
+    const std::vector<RGB> stops = {RGB(255, 0, 0), RGB(0, 255, 0), RGB(0, 0, 255)};
+    const Colormap map(stops);
+    std::vector<float> values;
+    for (int i = -10; i <= 110; ++i) {
+        values.push_back(static_cast<float>(i) / 100.0f);
+    }
+    std::vector<RGB> out(values.size());
+    map.map(values, out);
+    for (size_t i = 0; i < values.size(); ++i) {
+        CHECK(out[i] == map.sample(values[i]));
+    }
+}
@@ -0,0 +1,124 @@
+#include <doctest/doctest.h>
+
+#include <pigment/pigment.hpp>
+
+#include <random>
+#include <span>
+#include <vector>
+
+using namespace pigment;
+
+namespace {
+    constexpr PorterDuff ALL_OPS[] = {PorterDuff::CLEAR,    PorterDuff::SRC,     PorterDuff::DST,
+                                      PorterDuff::SRC_OVER, PorterDuff::DST_OVER, PorterDuff::SRC_IN,
+                                      PorterDuff::DST_IN,   PorterDuff::SRC_OUT, PorterDuff::DST_OUT,
+                                      PorterDuff::SRC_ATOP, PorterDuff::DST_ATOP, PorterDuff::XOR,
+                                      PorterDuff::PLUS};
+
+    // Valid premultiplied pixels (every channel <= alpha), plus the fully transparent / opaque corners
+    std::vector<PremulRGBA> pixels(size_t n, uint32_t seed) {
+        std::mt19937 gen(seed);
+        std::vector<PremulRGBA> out;
+        out.reserve(n);
+        out.push_back(PremulRGBA(0, 0, 0, 0));
+        out.push_back(PremulRGBA(255, 255, 255, 255));
+        while (out.size() < n) {
+            const int a = static_cast<int>(gen() % 256);
+            auto channel = [&] { return static_cast<uint8_t>(gen() % (a + 1)); };
+            const uint8_t r = channel(), g = channel(), b = channel();
+            out.push_back(PremulRGBA(r, g, b, static_cast<uint8_t>(a)));
+        }
+        return out;
+    }
+
+    // Textbook Porter-Duff factors on 8-bit alphas, each term rounded to nearest
+    PremulRGBA reference(PorterDuff op, const PremulRGBA &s, const PremulRGBA &d) {
+        const uint32_t as = s.a(), ad = d.a();
+        uint32_t fa = 0, fb = 0;
+        switch (op) {
+        case PorterDuff::CLEAR:
+            break;
+        case PorterDuff::SRC:
+            fa = 255;
+            break;
+        case PorterDuff::DST:
+            fb = 255;
+            break;
+        case PorterDuff::SRC_OVER:
+            fa = 255, fb = 255 - as;
+            break;
+        case PorterDuff::DST_OVER:
+            fa = 255 - ad, fb = 255;
+            break;
+        case PorterDuff::SRC_IN:
+            fa = ad;
+            break;
+        case PorterDuff::DST_IN:
+            fb = as;
+            break;
+        case PorterDuff::SRC_OUT:
+            fa = 255 - ad;
+            break;
+        case PorterDuff::DST_OUT:
+            fb = 255 - as;
+            break;
+        case PorterDuff::SRC_ATOP:
+            fa = ad, fb = 255 - as;
+            break;
+        case PorterDuff::DST_ATOP:
+            fa = 255 - ad, fb = as;
+            break;
+        case PorterDuff::XOR:
+            fa = 255 - ad, fb = 255 - as;
+            break;
+        case PorterDuff::PLUS:
+            fa = 255, fb = 255;
+            break;
+        }
+        auto round255 = [](uint32_t x) { return (2 * x + 255) / 510; };
+        auto channel = [&](uint32_t sc, uint32_t dc) {
+            const uint32_t v = round255(sc * fa) + round255(dc * fb);
+            return static_cast<uint8_t>(v > 255 ? 255 : v);
+        };
+        return PremulRGBA(channel(s.r(), d.r()), channel(s.g(), d.g()), channel(s.b(), d.b()),
+                          channel(s.a(), d.a()));
+    }
+} // namespace
+
+TEST_CASE("scalar composite matches the reference for every operator") {
+    const std::vector<PremulRGBA> src = pixels(4096, 1), dst = pixels(4096, 2);
+    for (PorterDuff op : ALL_OPS) {
+        size_t mismatches = 0;
+        for (size_t i = 0; i < src.size(); ++i) {
+            mismatches += composite(op, src[i], dst[i]) != reference(op, src[i], dst[i]);
+        }
+        CHECK(mismatches == 0);
+    }
+}
+
+TEST_CASE("span composite matches scalar composite for every operator") {
+    // Odd length so the vector loop and its scalar tail both run
+    const std::vector<PremulRGBA> src = pixels(4099, 3), dst = pixels(4099, 4);
+    for (PorterDuff op : ALL_OPS) {
+        std::vector<PremulRGBA> out = dst;
+        composite(op, std::span<const PremulRGBA>(src), std::span<PremulRGBA>(out));
+        size_t mismatches = 0;
+        for (size_t i = 0; i < src.size(); ++i) {
+            mismatches += out[i] != composite(op, src[i], dst[i]);
+        }
+        CHECK(mismatches == 0);
+    }
+}
+
+TEST_CASE("span composite handles lengths below one vector") {
+    const std::vector<PremulRGBA> src = pixels(7, 5), dst = pixels(7, 6);
+    for (PorterDuff op : ALL_OPS) {
+        for (size_t n = 0; n <= src.size(); ++n) {
+            std::vector<PremulRGBA> out(dst.begin(), dst.begin() + n);
+            composite(op, std::span<const PremulRGBA>(src.data(), n), std::span<PremulRGBA>(out));
+            for (size_t i = 0; i < n; ++i) {
+                CHECK(out[i] == composite(op, src[i], dst[i]));
+            }
+        }
+    }
+}
@@ -0,0 +1,211 @@
+#include <doctest/doctest.h>
+
+#include <pigment/pigment.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace pigment;
+
+namespace {
+    struct ReferencePair {
+        LAB first;
+        LAB second;
+        double expected;
+    };
+
+    // Sharma, Wu & Dalal (2005), Table 1: the 34 CIEDE2000 test pairs, dE00 rounded to 4 decimals
+    const ReferencePair SHARMA_PAIRS[] = {
+        {LAB(50.0000, 2.6772, -79.7751), LAB(50.0000, 0.0000, -82.7485), 2.0425},
+        {LAB(50.0000, 3.1571, -77.2803), LAB(50.0000, 0.0000, -82.7485), 2.8615},
+        {LAB(50.0000, 2.8361, -74.0200), LAB(50.0000, 0.0000, -82.7485), 3.4412},
+        {LAB(50.0000, -1.3802, -84.2814), LAB(50.0000, 0.0000, -82.7485), 1.0000},
+        {LAB(50.0000, -1.1848, -84.8006), LAB(50.0000, 0.0000, -82.7485), 1.0000},
+        {LAB(50.0000, -0.9009, -85.5211), LAB(50.0000, 0.0000, -82.7485), 1.0000},
+        {LAB(50.0000, 0.0000, 0.0000), LAB(50.0000, -1.0000, 2.0000), 2.3669},
+        {LAB(50.0000, -1.0000, 2.0000), LAB(50.0000, 0.0000, 0.0000), 2.3669},
+        {LAB(50.0000, 2.4900, -0.0010), LAB(50.0000, -2.4900, 0.0009), 7.1792},
+        {LAB(50.0000, 2.4900, -0.0010), LAB(50.0000, -2.4900, 0.0010), 7.1792},
+        {LAB(50.0000, 2.4900, -0.0010), LAB(50.0000, -2.4900, 0.0011), 7.2195},
+        {LAB(50.0000, 2.4900, -0.0010), LAB(50.0000, -2.4900, 0.0012), 7.2195},
+        {LAB(50.0000, -0.0010, 2.4900), LAB(50.0000, 0.0009, -2.4900), 4.8045},
+        {LAB(50.0000, -0.0010, 2.4900), LAB(50.0000, 0.0010, -2.4900), 4.8045},
+        {LAB(50.0000, -0.0010, 2.4900), LAB(50.0000, 0.0011, -2.4900), 4.7461},
+        {LAB(50.0000, 2.5000, 0.0000), LAB(50.0000, 0.0000, -2.5000), 4.3065},
+        {LAB(50.0000, 2.5000, 0.0000), LAB(73.0000, 25.0000, -18.0000), 27.1492},
+        {LAB(50.0000, 2.5000, 0.0000), LAB(61.0000, -5.0000, 29.0000), 22.8977},
+        {LAB(50.0000, 2.5000, 0.0000), LAB(56.0000, -27.0000, -3.0000), 31.9030},
+        {LAB(50.0000, 2.5000, 0.0000), LAB(58.0000, 24.0000, 15.0000), 19.4535},
+        {LAB(50.0000, 2.5000, 0.0000), LAB(50.0000, 3.1736, 0.5854), 1.0000},
+        {LAB(50.0000, 2.5000, 0.0000), LAB(50.0000, 3.2972, 0.0000), 1.0000},
+        {LAB(50.0000, 2.5000, 0.0000), LAB(50.0000, 1.8634, 0.5757), 1.0000},
+        {LAB(50.0000, 2.5000, 0.0000), LAB(50.0000, 3.2592, 0.3350), 1.0000},
+        {LAB(60.2574, -34.0099, 36.2677), LAB(60.4626, -34.1751, 39.4387), 1.2644},
+        {LAB(63.0109, -31.0961, -5.8663), LAB(62.8187, -29.7946, -4.0864), 1.2630},
+        {LAB(61.2901, 3.7196, -5.3901), LAB(61.4292, 2.2480, -4.9620), 1.8731},
+        {LAB(35.0831, -44.1164, 3.7933), LAB(35.0232, -40.0716, 1.5901), 1.8645},
+        {LAB(22.7233, 20.0904, -46.6940), LAB(23.0331, 14.9730, -42.5619), 2.0373},
+        {LAB(36.4612, 47.8580, 18.3852), LAB(36.2715, 50.5065, 21.2231), 1.4146},
+        {LAB(90.8027, -2.0831, 1.4410), LAB(91.1528, -1.6435, 0.0447), 1.4441},
+        {LAB(90.9257, -0.5406, -0.9208), LAB(88.6381, -0.8985, -0.7239), 1.5381},
+        {LAB(6.7747, -0.2908, -2.4247), LAB(5.8714, -0.0985, -2.2286), 0.6377},
+        {LAB(2.0776, 0.0795, -1.1350), LAB(0.9033, -0.0636, -0.5514), 0.9082},
+    };
+
+    std::vector<LAB> random_labs(size_t n, uint32_t seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<double> lightness(0.0, 100.0);
+        std::uniform_real_distribution<double> axis(-110.0, 110.0);
+        std::vector<LAB> out;
+        out.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            out.emplace_back(lightness(rng), axis(rng), axis(rng));
+        }
+        return out;
+    }
+} // namespace
+
+TEST_CASE("delta_e_2000 matches the Sharma et al. reference pairs") {
+    for (const auto &pair : SHARMA_PAIRS) {
+        CHECK(std::abs(pair.first.delta_e_2000(pair.second) - pair.expected) < 1e-4);
+        // CIEDE2000 is symmetric in its two arguments
+        CHECK(std::abs(pair.second.delta_e_2000(pair.first) - pair.expected) < 1e-4);
+    }
+}
+
+TEST_CASE("delta_e_2000 parametric weights scale their own term") {
+    const LAB a(40.0, 10.0, -10.0);
+    const LAB lighter(50.0, 10.0, -10.0);
+    CHECK(a.delta_e_2000(a) == 0.0);
+    // Pure lightness difference: only the kL term contributes
+    CHECK(std::abs(a.delta_e_2000(lighter, 2.0) - a.delta_e_2000(lighter) / 2.0) < 1e-12);
+    CHECK(std::abs(a.delta_e_2000(lighter, 1.0, 3.0, 3.0) - a.delta_e_2000(lighter)) < 1e-12);
+}
+
+TEST_CASE("delta_e_94 follows the reference-weighted formula") {
+    const LAB reference(50.0, 30.0, 40.0);
+    CHECK(reference.delta_e_94(reference) == 0.0);
+
+    // Lightness only: dL / kL
+    const LAB darker(40.0, 30.0, 40.0);
+    CHECK(std::abs(reference.delta_e_94(darker) - 10.0) < 1e-12);
+    CHECK(std::abs(reference.delta_e_94(darker, 2.0, 0.048, 0.014) - 5.0) < 1e-12);
+
+    // Chroma only, same hue: dC / (1 + k1 * C_ref) with C_ref = 50
+    const LAB duller(50.0, 24.0, 32.0);
+    CHECK(std::abs(reference.delta_e_94(duller) - 10.0 / (1.0 + 0.045 * 50.0)) < 1e-12);
+
+    // Hue only, same chroma: dH / (1 + k2 * C_ref)
+    const LAB rotated(50.0, 40.0, 30.0);
+    CHECK(std::abs(reference.delta_e_94(rotated) - std::sqrt(200.0) / (1.0 + 0.015 * 50.0)) < 1e-12);
+
+    // Weights come from the reference, so the metric is not symmetric
+    CHECK(duller.delta_e_94(reference) > reference.delta_e_94(duller));
+
+    // Near-identical hues must not produce NaN from a slightly negative dH^2
+    const LAB nudged(50.0, 30.0 * (1.0 + 1e-15), 40.0 * (1.0 + 1e-15));
+    CHECK(std::isfinite(reference.delta_e_94(nudged)));
+}
+
+TEST_CASE("is_within_2000 agrees with delta_e_2000") {
+    const auto first = random_labs(4000, 7);
+    const auto second = random_labs(4000, 11);
+    for (double threshold : {0.5, 2.3, 10.0, 40.0}) {
+        for (size_t i = 0; i < first.size(); ++i) {
+            // Nudge the second color toward the first so small thresholds see both outcomes
+            const double t = static_cast<double>(i % 101) / 100.0;
+            const LAB near(first[i].l() + (second[i].l() - first[i].l()) * t * 0.1,
+                           first[i].a() + (second[i].a() - first[i].a()) * t * 0.1,
+                           first[i].b() + (second[i].b() - first[i].b()) * t * 0.1);
+            for (const LAB &other : {second[i], near}) {
+                const double d = first[i].delta_e_2000(other);
+                if (std::abs(d - threshold) < 1e-9) {
+                    continue;
+                }
+                CHECK(first[i].is_within_2000(other, threshold) == (d < threshold));
+            }
+        }
+    }
+
+    // The early exit is taken on lightness alone; it must still honor kL
+    const LAB a(50.0, 0.0, 0.0);
+    const LAB b(53.0, 0.0, 0.0);
+    CHECK_FALSE(a.is_within_2000(b, 2.0));
+    CHECK(a.is_within_2000(b, 2.0, 3.0));
+}
+
+TEST_CASE("batch kernels match the scalar path") {
+    const auto colors = random_labs(257, 3);
+    const auto others = random_labs(257, 5);
+    const LAB reference(62.0, -12.0, 33.0);
+    std::vector<double> out(colors.size());
+
+    delta_e_76(reference, colors, out);
+    for (size_t i = 0; i < colors.size(); ++i) {
+        CHECK(out[i] == reference.delta_e(colors[i]));
+    }
+
+    delta_e_94(reference, colors, out);
+    for (size_t i = 0; i < colors.size(); ++i) {
+        CHECK(out[i] == reference.delta_e_94(colors[i]));
+    }
+
+    delta_e_2000(reference, colors, out);
+    for (size_t i = 0; i < colors.size(); ++i) {
+        CHECK(out[i] == reference.delta_e_2000(colors[i]));
+    }
+
+    delta_e_2000(colors, others, out);
+    for (size_t i = 0; i < colors.size(); ++i) {
+        CHECK(out[i] == colors[i].delta_e_2000(others[i]));
+    }
+}
+
+TEST_CASE("mask kernels match the scalar path") {
+    const auto colors = random_labs(300, 13);
+    const auto others = random_labs(300, 17);
+    const LAB reference(50.0, 0.0, 0.0);
+    std::vector<uint8_t> mask(colors.size(), 0xAA);
+
+    for (double threshold : {5.0, 25.0, 60.0}) {
+        size_t count = within_2000(reference, colors, threshold, mask);
+        size_t expected = 0;
+        for (size_t i = 0; i < colors.size(); ++i) {
+            const bool within = reference.delta_e_2000(colors[i]) < threshold;
+            CHECK(mask[i] == (within ? 1 : 0));
+            expected += within;
+        }
+        CHECK(count == expected);
+
+        count = within_2000(colors, others, threshold, mask);
+        expected = 0;
+        for (size_t i = 0; i < colors.size(); ++i) {
+            const bool within = colors[i].delta_e_2000(others[i]) < threshold;
+            CHECK(mask[i] == (within ? 1 : 0));
+            expected += within;
+        }
+        CHECK(count == expected);
+    }
+}
+
+TEST_CASE("batch kernels reject undersized or mismatched spans") {
+    const auto colors = random_labs(8, 1);
+    const auto shorter = random_labs(7, 2);
+    const LAB reference;
+    std::vector<double> small(7);
+    std::vector<double> out(8);
+    std::vector<uint8_t> small_mask(7);
+    std::vector<uint8_t> mask(8);
+
+    CHECK_THROWS_AS(delta_e_76(reference, colors, small), std::invalid_argument);
+    CHECK_THROWS_AS(delta_e_94(reference, colors, small), std::invalid_argument);
+    CHECK_THROWS_AS(delta_e_2000(reference, colors, small), std::invalid_argument);
+    CHECK_THROWS_AS(delta_e_2000(colors, shorter, out), std::invalid_argument);
+    CHECK_THROWS_AS(delta_e_2000(colors, colors, small), std::invalid_argument);
+    CHECK_THROWS_AS(within_2000(reference, colors, 1.0, small_mask), std::invalid_argument);
+    CHECK_THROWS_AS(within_2000(colors, shorter, 1.0, mask), std::invalid_argument);
+    CHECK_THROWS_AS(within_2000(colors, colors, 1.0, small_mask), std::invalid_argument);
+}
@@ -0,0 +1,70 @@
+#include <doctest/doctest.h>
+
+#include <pigment/pigment.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+using namespace pigment;
+
+namespace {
+    // Every 7th RGB input (~2.4M colors, every channel value appears)
+    std::vector<RGB> sweep() {
+        std::vector<RGB> colors;
+        colors.reserve((1u << 24) / 7 + 1);
+        for (uint32_t key = 0; key < (1u << 24); key += 7) {
+            colors.push_back(RGB((key >> 16) & 0xFF, (key >> 8) & 0xFF, key & 0xFF));
+        }
+        return colors;
+    }
+} // namespace
+
+TEST_CASE("LABf: scalar fromRGB and batch convert agree") {
+    const std::vector<RGB> colors = sweep();
+    std::vector<LABf> batch(colors.size());
+    convert(std::span<const RGB>(colors), std::span<LABf>(batch));
+    float worst = 0.0f;
+    for (size_t i = 0; i < colors.size(); ++i) {
+        worst = std::max(worst, LABf::fromRGB(colors[i]).delta_e(batch[i]));
+    }
+    // The float kernels are within 5.2e-4 dE of exact LAB over the whole cube (see bench/accuracy.cpp)
+    CHECK(worst <= 1e-3f);
+}
+
+TEST_CASE("OKLABf: scalar fromRGB and batch convert agree") {
+    const std::vector<RGB> colors = sweep();
+    std::vector<OKLABf> batch(colors.size());
+    convert(std::span<const RGB>(colors), std::span<OKLABf>(batch));
+    float worst = 0.0f;
+    for (size_t i = 0; i < colors.size(); ++i) {
+        worst = std::max(worst, OKLABf::fromRGB(colors[i]).distance(batch[i]));
+    }
+    CHECK(worst <= 1e-5f);
+}
+
+TEST_CASE("LCHf: direct and through-LABf routes agree") {
+    const std::vector<RGB> colors = sweep();
+    std::vector<LABf> lab(colors.size());
+    std::vector<LCHf> lch(colors.size());
+    convert(std::span<const RGB>(colors), std::span<LABf>(lab));
+    convert(std::span<const RGB>(colors), std::span<LCHf>(lch));
+    float worst = 0.0f;
+    for (size_t i = 0; i < colors.size(); ++i) {
+        worst = std::max(worst, lch[i].to_lab().delta_e(lab[i]));
+    }
+    CHECK(worst <= 1e-3f);
+}
+
+TEST_CASE("float types round-trip every sampled color") {
+    const std::vector<RGB> colors = sweep();
+    size_t mismatches = 0;
+    for (const RGB &c : colors) {
+        mismatches += LABf::fromRGB(c).to_rgb() != c;
+        mismatches += OKLABf::fromRGB(c).to_rgb() != c;
+        mismatches += LCHf::fromRGB(c).to_rgb() != c;
+    }
+    CHECK(mismatches == 0);
+}
@@ -0,0 +1,110 @@
+#include <doctest/doctest.h>
+
+#include <pigment/pigment.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+using namespace pigment;
+
+namespace {
+    constexpr Lut3D::Interpolation MODES[] = {Lut3D::Interpolation::TRILINEAR, Lut3D::Interpolation::TETRAHEDRAL};
+
+    // Sizes whose spacing 255 / (size - 1) is fractional, plus the two exact ones
+    constexpr size_t SIZES[] = {2, 5, 16, Lut3D::SMALL, Lut3D::MEDIUM, Lut3D::LARGE, 100, 256};
+
+    uint8_t node_level(size_t i, size_t size) {
+        return static_cast<uint8_t>(static_cast<double>(i) * 255.0 / static_cast<double>(size - 1) + 0.5);
+    }
+
+    RGB curve(const RGB &c) {
+        auto gamma = [](uint8_t v) { return static_cast<uint8_t>(std::pow(v / 255.0, 2.2) * 255.0 + 0.5); };
+        return RGB(gamma(c.g()), 255 - c.b(), gamma(c.r()), c.a());
+    }
+} // namespace
+
+TEST_CASE("identity cube reproduces every input") {
+    for (size_t size : SIZES) {
+        const Lut3D lut = Lut3D::bake([](const RGB &c) { return c; }, size);
+        for (Lut3D::Interpolation mode : MODES) {
+            size_t mismatches = 0;
+            for (uint32_t key = 0; key < (1u << 24); key += 61) {
+                const RGB c((key >> 16) & 0xFF, (key >> 8) & 0xFF, key & 0xFF);
+                mismatches += lut.apply(c, mode) != c;
+            }
+            CHECK(mismatches == 0);
+        }
+    }
+}
+
+TEST_CASE("inputs on lattice nodes return the baked value") {
+    for (size_t size : {size_t(5), Lut3D::SMALL, Lut3D::MEDIUM}) {
+        const Lut3D lut = Lut3D::bake(curve, size);
+        for (Lut3D::Interpolation mode : MODES) {
+            size_t mismatches = 0;
+            for (size_t b = 0; b < size; ++b) {
+                for (size_t g = 0; g < size; ++g) {
+                    for (size_t r = 0; r < size; ++r) {
+                        const RGB c(node_level(r, size), node_level(g, size), node_level(b, size));
+                        mismatches += lut.apply(c, mode) != curve(c);
+                    }
+                }
+            }
+            CHECK(mismatches == 0);
+        }
+    }
+}
+
+TEST_CASE("per-channel affine maps interpolate exactly") {
+    auto invert = [](const RGB &c) { return RGB(255 - c.r(), c.g(), 255 - c.b(), c.a()); };
+    for (size_t size : SIZES) {
+        const Lut3D lut = Lut3D::bake(invert, size);
+        for (Lut3D::Interpolation mode : MODES) {
+            size_t mismatches = 0;
+            for (uint32_t key = 0; key < (1u << 24); key += 61) {
+                const RGB c((key >> 16) & 0xFF, (key >> 8) & 0xFF, key & 0xFF, 77);
+                mismatches += lut.apply(c, mode) != invert(c);
+            }
+            CHECK(mismatches == 0);
+        }
+    }
+}
+
+TEST_CASE("batch apply matches the single-pixel lookup") {
+    const Lut3D lut = Lut3D::bake(curve, Lut3D::SMALL);
+    std::vector<RGB> src;
+    for (uint32_t key = 0; key < (1u << 24); key += 4099) {
+        src.push_back(RGB((key >> 16) & 0xFF, (key >> 8) & 0xFF, key & 0xFF, static_cast<uint8_t>(key)));
+    }
+    std::vector<RGB> dst(src.size());
+    lut.apply(src, dst);
+    size_t mismatches = 0;
+    for (size_t i = 0; i < src.size(); ++i) {
+        mismatches += dst[i] != lut.apply(src[i]);
+    }
+    CHECK(mismatches == 0);
+}
+
+TEST_CASE("bake rejects sizes outside [2, 256]") {
+    CHECK_THROWS_AS(Lut3D::bake([](const RGB &c) { return c; }, 1), std::invalid_argument);
+    CHECK_THROWS_AS(Lut3D::bake([](const RGB &c) { return c; }, 257), std::invalid_argument);
+}
+
+TEST_CASE("empty cube refuses every lookup") {
+    Lut3D lut;
+    REQUIRE(lut.empty());
+    CHECK_THROWS_AS(lut.apply(RGB(1, 2, 3)), std::invalid_argument);
+    CHECK_THROWS_AS(lut.apply(RGB(1, 2, 3), Lut3D::Interpolation::TRILINEAR), std::invalid_argument);
+
+    std::vector<RGB> src(4, RGB(10, 20, 30)), dst(4);
+    CHECK_THROWS_AS(lut.apply(src, dst), std::invalid_argument);
+    PlanarImage<RGB> image(2, 2);
+    CHECK_THROWS_AS(lut.apply(image), std::invalid_argument);
+
+    // A default-constructed cube assigned later works as usual
+    lut = ColorTransform().lighten(0.1).to_lut(Lut3D::SMALL);
+    CHECK_FALSE(lut.empty());
+    CHECK_NOTHROW(lut.apply(src, dst));
+}
@@ -0,0 +1,74 @@
+#include <doctest/doctest.h>
+
+#include <pigment/named_colors.hpp>
+
+#include <string>
+
+using namespace pigment;
+
+static_assert(colors::lookup("SkyBlue").has_value());
+static_assert(!colors::lookup("notacolor").has_value());
+
+namespace {
+    bool same(const RGB &a, const RGB &b) {
+        return a.r() == b.r() && a.g() == b.g() && a.b() == b.b() && a.a() == b.a();
+    }
+} // namespace
+
+TEST_CASE("lookup ignores case") {
+    const auto lower = colors::lookup("skyblue");
+    REQUIRE(lower.has_value());
+    CHECK(same(*lower, RGB(135, 206, 235)));
+    CHECK(same(*colors::lookup("SkyBlue"), *lower));
+    CHECK(same(*colors::lookup("SKYBLUE"), *lower));
+    CHECK(same(*colors::lookup("sKyBlUe"), *lower));
+}
+
+TEST_CASE("lookup rejects unknown names") {
+    CHECK_FALSE(colors::lookup("").has_value());
+    CHECK_FALSE(colors::lookup("nocolor").has_value());
+    CHECK_FALSE(colors::lookup("skyblu").has_value());
+    CHECK_FALSE(colors::lookup("skyblue2").has_value());
+    CHECK_FALSE(colors::lookup(" skyblue").has_value());
+    CHECK_FALSE(colors::lookup("zzz").has_value());
+}
+
+TEST_CASE("table agrees with the accessor functions") {
+    CHECK(colors::TABLE.front().name == "aliceblue");
+    CHECK(colors::TABLE.back().name == "yellowgreen");
+    CHECK(same(*colors::lookup("indianred"), colors::indianred()));
+    CHECK(same(*colors::lookup("rebeccapurple"), colors::rebeccapurple()));
+    CHECK(same(*colors::lookup("black"), colors::black()));
+    CHECK(same(*colors::lookup("white"), colors::white()));
+
+    for (const auto &entry : colors::TABLE) {
+        const auto found = colors::lookup(entry.name);
+        REQUIRE(found.has_value());
+        CHECK(same(*found, entry.color));
+
+        std::string upper(entry.name);
+        for (char &c : upper) {
+            c = static_cast<char>(c - 'a' + 'A');
+        }
+        CHECK(same(*colors::lookup(upper), entry.color));
+    }
+}
+
+TEST_CASE("nearest_name resolves aliases to the first name") {
+    CHECK(colors::nearest_name(RGB(0, 255, 255)) == "aqua");
+    CHECK(colors::nearest_name(colors::cyan()) == "aqua");
+    CHECK(colors::nearest_name(RGB(255, 0, 255)) == "fuchsia");
+    CHECK(colors::nearest_name(colors::magenta()) == "fuchsia");
+
+    for (const auto &entry : colors::TABLE) {
+        const auto name = colors::nearest_name(entry.color);
+        CHECK(same(*colors::lookup(name), entry.color));
+        CHECK(name <= entry.name);
+    }
+}
+
+TEST_CASE("nearest_name picks the closest entry") {
+    CHECK(colors::nearest_name(RGB(254, 0, 1)) == "red");
+    CHECK(colors::nearest_name(RGB(1, 1, 1)) == "black");
+    CHECK(colors::nearest_name(RGB(128, 0, 129)) == "purple");
+}
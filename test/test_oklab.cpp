@@ -0,0 +1,47 @@
+#include <doctest/doctest.h>
+
+#include <pigment/pigment.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+
+using namespace pigment;
+
+namespace {
+    RGB rgb_of(uint32_t key) { return RGB((key >> 16) & 0xFF, (key >> 8) & 0xFF, key & 0xFF); }
+
+    int max_channel_error(const RGB &a, const RGB &b) {
+        return std::max({std::abs(a.r() - b.r()), std::abs(a.g() - b.g()), std::abs(a.b() - b.b())});
+    }
+} // namespace
+
+TEST_CASE("OKLAB::fromRGB_fast stays within its documented bound on every input") {
+    double worst = 0.0;
+    for (uint32_t key = 0; key < (1u << 24); ++key) {
+        const RGB c = rgb_of(key);
+        const OKLAB exact = OKLAB::fromRGB(c), fast = OKLAB::fromRGB_fast(c);
+        worst = std::max({worst, std::fabs(exact.l() - fast.l()), std::fabs(exact.a() - fast.a()),
+                          std::fabs(exact.b() - fast.b())});
+    }
+    CHECK(worst <= oklab_tables::FAST_FROM_RGB_MAX_ERROR);
+}
+
+TEST_CASE("OKLAB::to_rgb_fast stays within its documented bound on every input") {
+    int worst = 0;
+    for (uint32_t key = 0; key < (1u << 24); ++key) {
+        const OKLAB lab = OKLAB::fromRGB(rgb_of(key));
+        worst = std::max(worst, max_channel_error(lab.to_rgb(), lab.to_rgb_fast()));
+    }
+    CHECK(worst <= oklab_tables::FAST_TO_RGB_MAX_CHANNEL_ERROR);
+}
+
+TEST_CASE("OKLAB round trip is exact on every input") {
+    uint64_t mismatches = 0;
+    for (uint32_t key = 0; key < (1u << 24); ++key) {
+        const RGB c = rgb_of(key);
+        mismatches += OKLAB::fromRGB(c).to_rgb() != c;
+    }
+    CHECK(mismatches == 0);
+}
@@ -0,0 +1,105 @@
+#include <doctest/doctest.h>
+
+#include <pigment/pigment.hpp>
+
+#include <stdexcept>
+#include <string>
+
+using namespace pigment;
+
+namespace {
+    bool same(const RGB &c, int r, int g, int b, int a = 255) {
+        return c.r() == r && c.g() == g && c.b() == b && c.a() == a;
+    }
+} // namespace
+
+TEST_CASE("string constructor reads hex forms") {
+    CHECK(same(RGB(std::string("#ff8000")), 255, 128, 0));
+    CHECK(same(RGB(std::string("ff8000")), 255, 128, 0));
+    CHECK(same(RGB(std::string("#f80")), 255, 136, 0));
+    CHECK(same(RGB(std::string("#11223344")), 0x11, 0x22, 0x33, 0x44));
+    CHECK(same(RGB(std::string("#AbCdEf")), 0xab, 0xcd, 0xef));
+}
+
+TEST_CASE("string constructor reads CSS forms") {
+    CHECK(same(RGB(std::string("rgb(255, 0, 10)")), 255, 0, 10));
+    CHECK(same(RGB(std::string("rgba(1,2,3,0.5)")), 1, 2, 3, 127));
+    CHECK(same(RGB(std::string("rgb(300,-5,12.7)")), 255, 0, 12));
+}
+
+TEST_CASE("string constructor keeps its lenient readings") {
+    // Spaces are dropped before splitting, so a space inside a number joins the digits
+    CHECK(same(RGB(std::string("rgb(2 55,0,0)")), 255, 0, 0));
+    // A trailing comma does not add a component
+    CHECK(same(RGB(std::string("rgb(255,0,0,)")), 255, 0, 0));
+    // Hex pairs keep their leading digits
+    CHECK(same(RGB(std::string("#1z2z3z")), 1, 2, 3));
+}
+
+TEST_CASE("string constructor rejects") {
+    CHECK_THROWS_AS(RGB(std::string("")), std::invalid_argument);
+    CHECK_THROWS_AS(RGB(std::string("#12345")), std::invalid_argument);
+    CHECK_THROWS_AS(RGB(std::string("#zz0000")), std::invalid_argument);
+    CHECK_THROWS_AS(RGB(std::string("rgb(1,2)")), std::invalid_argument);
+    CHECK_THROWS_AS(RGB(std::string("rgb(1,2,3,4,5)")), std::invalid_argument);
+    CHECK_THROWS_AS(RGB(std::string("rgb(1,2,3")), std::invalid_argument);
+    CHECK_THROWS_AS(RGB(std::string("rgba(1,2,3,nan)")), std::invalid_argument);
+    CHECK_THROWS_AS(RGB(std::string("rgba(1,2,3,inf)")), std::invalid_argument);
+}
+
+TEST_CASE("parse accepts the well-formed inputs") {
+    REQUIRE(RGB::parse("#ff8000").has_value());
+    CHECK(same(*RGB::parse("#ff8000"), 255, 128, 0));
+    CHECK(same(*RGB::parse("f80"), 255, 136, 0));
+    CHECK(same(*RGB::parse("#11223344"), 0x11, 0x22, 0x33, 0x44));
+    CHECK(same(*RGB::parse("rgb( 255 , 0 , 10 )"), 255, 0, 10));
+    CHECK(same(*RGB::parse("rgba(1,2,3,0.5)"), 1, 2, 3, 127));
+    CHECK(same(*RGB::parse("rgb(300,-5,12.7)"), 255, 0, 12));
+    CHECK(same(*RGB::parse_css("rgb(+4,5,6)"), 4, 5, 6));
+    static_assert(RGB::parse_hex("#102030").has_value());
+    static_assert(!RGB::parse_hex("#10203g").has_value());
+}
+
+TEST_CASE("parse rejects what the constructor tolerates") {
+    CHECK_FALSE(RGB::parse("rgb(2 55,0,0)").has_value());
+    CHECK_FALSE(RGB::parse("rgb(255,0,0,)").has_value());
+    CHECK_FALSE(RGB::parse("#1z2z3z").has_value());
+}
+
+TEST_CASE("parse rejects non-finite alpha and clamps large alpha") {
+    for (const char *bad : {"rgba(1,2,3,nan)", "rgba(1,2,3,NAN)", "rgba(1,2,3,inf)", "rgba(1,2,3,-inf)",
+                            "rgba(1,2,3,infinity)"}) {
+        CHECK_FALSE(RGB::parse(bad).has_value());
+    }
+    CHECK(same(*RGB::parse("rgba(1,2,3,1e300)"), 1, 2, 3, 255));
+    CHECK(same(*RGB::parse("rgba(1,2,3,-1e300)"), 1, 2, 3, 0));
+    CHECK(same(*RGB::parse("rgba(1,2,3,3e9)"), 1, 2, 3, 255));
+    CHECK(same(RGB(std::string("rgba(1,2,3,1e300)")), 1, 2, 3, 255));
+}
+
+TEST_CASE("parse rejects malformed input") {
+    for (const char *bad : {"", "#", "#12345", "#zz0000", "#1234567", "rgb(1,2)", "rgb(1,2,3,4,5)", "rgb(1,2,3",
+                            "rgb(a,b,c)", "rgb(1;2;3)", "rgba(1,2,3,x)", "hsl(1,2,3)"}) {
+        CHECK_FALSE(RGB::parse(bad).has_value());
+    }
+    CHECK_FALSE(RGB::parse_hex("rgb(1,2,3)").has_value());
+    CHECK_FALSE(RGB::parse_css("#ffffff").has_value());
+}
+
+TEST_CASE("parse and the constructor agree wherever parse succeeds") {
+    for (const char *text : {"#000", "#fff", "#0a0b0c", "#DEADBEEF", "rgb(0,0,0)", "rgb(12, 34, 56)",
+                             "rgba(255,255,255,1)", "rgba(9,8,7,0)", "rgba(9,8,7,2.5)", "rgb(1.9,2.9,3.9)"}) {
+        const std::optional<RGB> parsed = RGB::parse(text);
+        REQUIRE(parsed.has_value());
+        CHECK(*parsed == RGB(std::string(text)));
+    }
+}
+
+TEST_CASE("hex formatting round-trips") {
+    const RGB color(18, 52, 86, 120);
+    CHECK(color.to_hex() == "#123456");
+    CHECK(color.to_hex(true) == "#12345678");
+    CHECK(*RGB::parse(color.to_hex(true)) == color);
+    char buffer[RGB::HEX_MAX_LENGTH];
+    CHECK(std::string(buffer, color.to_hex(buffer)) == "#123456");
+}
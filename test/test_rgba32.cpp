@@ -0,0 +1,120 @@
+#include <doctest/doctest.h>
+
+#include <pigment/pigment.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+using namespace pigment;
+
+namespace {
+    bool same(const RGBA32 &packed, const RGB &color) {
+        return packed.r() == color.r() && packed.g() == color.g() && packed.b() == color.b() &&
+               packed.a() == color.a();
+    }
+
+    RGBA32 with_lane(uint32_t base, unsigned lane, uint8_t byte) {
+        const unsigned shift = lane * 8;
+        return RGBA32((base & ~(0xFFu << shift)) | (static_cast<uint32_t>(byte) << shift));
+    }
+} // namespace
+
+TEST_CASE("saturating add and subtract match RGB in every lane for every byte pair") {
+    std::mt19937 rng(42);
+    size_t mismatches = 0;
+    for (unsigned lane = 0; lane < 4; ++lane) {
+        for (unsigned x = 0; x < 256; ++x) {
+            for (unsigned y = 0; y < 256; ++y) {
+                // Random neighbours catch carries or borrows leaking across byte boundaries
+                const RGBA32 p = with_lane(rng(), lane, static_cast<uint8_t>(x));
+                const RGBA32 q = with_lane(rng(), lane, static_cast<uint8_t>(y));
+                const RGB a = p.to_rgb(), b = q.to_rgb();
+                mismatches += !same(p + q, a + b) || !same(p - q, a - b);
+            }
+        }
+    }
+    CHECK(mismatches == 0);
+}
+
+TEST_CASE("saturating add and subtract clamp at the byte edges") {
+    // 0xFF + 0x01 saturates each byte without carrying into the next one
+    CHECK((RGBA32(0xFFFFFFFFu) + RGBA32(0x01010101u)).value == 0xFFFFFFFFu);
+    CHECK((RGBA32(0x00FF00FFu) + RGBA32(0x01010101u)).value == 0x01FF01FFu);
+    CHECK((RGBA32(0xFF00FF00u) + RGBA32(0x01010101u)).value == 0xFF01FF01u);
+    CHECK((RGBA32(0x80808080u) + RGBA32(0x80808080u)).value == 0xFFFFFFFFu);
+    CHECK((RGBA32(0x7F7F7F7Fu) + RGBA32(0x80808080u)).value == 0xFFFFFFFFu);
+
+    // 0x00 - 0x01 floors each byte at zero without borrowing from the next one
+    CHECK((RGBA32(0x00000000u) - RGBA32(0x01010101u)).value == 0x00000000u);
+    CHECK((RGBA32(0x00FF00FFu) - RGBA32(0x01010101u)).value == 0x00FE00FEu);
+    CHECK((RGBA32(0xFF00FF00u) - RGBA32(0x01010101u)).value == 0xFE00FE00u);
+    CHECK((RGBA32(0x7F7F7F7Fu) - RGBA32(0x80808080u)).value == 0x00000000u);
+    CHECK((RGBA32(0x80808080u) - RGBA32(0x7F7F7F7Fu)).value == 0x01010101u);
+
+    RGBA32 c(250, 5, 128, 255);
+    c += RGBA32(10, 10, 10, 0);
+    CHECK(c == RGBA32(255, 15, 138, 255));
+    c -= RGBA32(20, 20, 200, 255);
+    CHECK(c == RGBA32(235, 0, 0, 0));
+}
+
+TEST_CASE("conversion to and from RGB keeps every channel") {
+    const RGB color(12, 34, 56, 78);
+    const RGBA32 packed(color);
+    CHECK(packed.r() == 12);
+    CHECK(packed.g() == 34);
+    CHECK(packed.b() == 56);
+    CHECK(packed.a() == 78);
+    CHECK(packed.to_rgb() == color);
+    CHECK(RGBA32().to_rgb() == RGB());
+    CHECK(packed.invert().to_rgb() == color.invert());
+
+    std::vector<RGB> colors = {RGB(1, 2, 3), RGB(255, 0, 128, 7), RGB(9, 9, 9, 0)};
+    std::vector<RGBA32> packed_colors(colors.size());
+    std::vector<RGB> back(colors.size());
+    pack(colors, packed_colors);
+    unpack(packed_colors, back);
+    CHECK(back == colors);
+    CHECK_THROWS_AS(pack(colors, std::span<RGBA32>(packed_colors).first(2)), std::invalid_argument);
+}
+
+TEST_CASE("hash of RGB is consistent with equality and spreads nearby colors") {
+    const std::hash<RGB> hash_rgb;
+    CHECK(hash_rgb(RGB(10, 20, 30)) == hash_rgb(RGB(10, 20, 30)));
+    CHECK(hash_rgb(RGB(10, 20, 30)) == std::hash<RGBA32>{}(RGBA32(10, 20, 30)));
+    CHECK(hash_rgb(RGB(10, 20, 30, 255)) != hash_rgb(RGB(10, 20, 30, 254)));
+
+    // The finalizer is a bijection on 32 bits, so distinct colors never collide outright
+    std::unordered_set<size_t> seen;
+    for (unsigned r = 0; r < 64; ++r) {
+        for (unsigned g = 0; g < 64; ++g) {
+            for (unsigned b = 0; b < 16; ++b) {
+                seen.insert(hash_rgb(RGB(static_cast<uint8_t>(r), static_cast<uint8_t>(g), static_cast<uint8_t>(b))));
+            }
+        }
+    }
+    CHECK(seen.size() == 64u * 64u * 16u);
+
+    // A dark gradient differs only in the low bits; it must still fill most buckets of a power-of-two table
+    constexpr size_t buckets = 1024;
+    std::vector<unsigned> load(buckets, 0);
+    for (unsigned i = 0; i < buckets; ++i) {
+        ++load[hash_rgb(RGB(static_cast<uint8_t>(i & 31), static_cast<uint8_t>(i >> 5), 0)) & (buckets - 1)];
+    }
+    size_t used = 0;
+    for (unsigned n : load) {
+        used += n != 0;
+    }
+    CHECK(used > buckets / 2);
+
+    std::unordered_map<RGB, int> counts;
+    ++counts[RGB(1, 2, 3)];
+    ++counts[RGB(1, 2, 3)];
+    ++counts[RGB(1, 2, 3, 0)];
+    CHECK(counts.size() == 2);
+    CHECK(counts[RGB(1, 2, 3)] == 2);
+}
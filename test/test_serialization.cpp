@@ -0,0 +1,196 @@
+#include <doctest/doctest.h>
+
+#include <pigment/pigment.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+using namespace pigment;
+using serialization::Header;
+using serialization::Layout;
+
+namespace {
+    const Layout ALL_LAYOUTS[] = {Layout::INTERLEAVED, Layout::PLANAR, Layout::DELTA};
+
+    // Gradient, flat stretch and noise, so DELTA emits both literal and run packets
+    std::vector<RGB> sample_colors(size_t n) {
+        std::vector<RGB> colors;
+        colors.reserve(n);
+        uint32_t state = 12345;
+        for (size_t i = 0; i < n; ++i) {
+            if (i < n / 3) {
+                colors.emplace_back(static_cast<uint8_t>(i), static_cast<uint8_t>(2 * i), 40, 255);
+            } else if (i < 2 * n / 3) {
+                colors.emplace_back(200, 100, 50, 255);
+            } else {
+                state = state * 1664525u + 1013904223u;
+                colors.emplace_back(static_cast<uint8_t>(state >> 8), static_cast<uint8_t>(state >> 16),
+                                    static_cast<uint8_t>(state >> 24), static_cast<uint8_t>(state));
+            }
+        }
+        return colors;
+    }
+
+    bool same(const std::vector<RGB> &a, const std::vector<RGB> &b) {
+        if (a.size() != b.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (!(a[i] == b[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    Header header_of(const std::vector<uint8_t> &bytes) {
+        Header header;
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        return header;
+    }
+
+    void set_header(std::vector<uint8_t> &bytes, const Header &header) {
+        std::memcpy(bytes.data(), &header, sizeof(header));
+    }
+} // namespace
+
+TEST_CASE("every layout round-trips") {
+    for (size_t n : {size_t(0), size_t(1), size_t(2), size_t(3), size_t(130), size_t(1000)}) {
+        const auto colors = sample_colors(n);
+        for (Layout layout : ALL_LAYOUTS) {
+            const auto bytes = serialization::serialize(colors, layout);
+            CHECK(bytes.size() == serialization::serialized_size(std::span<const RGB>(colors), layout));
+
+            const auto view = serialization::view<RGB>(bytes);
+            CHECK(view.layout() == layout);
+            CHECK(view.size() == n);
+            CHECK(same(view.to_vector(), colors));
+        }
+    }
+}
+
+TEST_CASE("views expose interleaved and planar payloads in place") {
+    const auto colors = sample_colors(64);
+
+    const auto interleaved = serialization::serialize(colors, Layout::INTERLEAVED);
+    const auto flat = serialization::view<RGB>(interleaved);
+    REQUIRE(flat.colors().size() == colors.size());
+    CHECK(flat.colors()[10] == colors[10]);
+    CHECK_THROWS_AS(flat.plane(0), std::logic_error);
+
+    const auto planar = serialization::serialize(colors, Layout::PLANAR);
+    const auto planes = serialization::view<RGB>(planar);
+    for (size_t c = 0; c < 4; ++c) {
+        const auto plane = planes.plane(c);
+        REQUIRE(plane.size() == colors.size());
+        for (size_t i = 0; i < colors.size(); ++i) {
+            CHECK(plane[i] == color_traits<RGB>::data(colors[i])[c]);
+        }
+    }
+    CHECK_THROWS_AS(planes.plane(4), std::out_of_range);
+    CHECK_THROWS_AS(planes.colors(), std::logic_error);
+}
+
+TEST_CASE("delta layout compresses flat data and round-trips float types only in raw layouts") {
+    const std::vector<RGB> flat(5000, RGB(10, 20, 30));
+    CHECK(serialization::serialize(flat, Layout::DELTA).size() * 50 < serialization::serialize(flat).size());
+
+    const std::vector<LAB> labs = {LAB(50.0, 1.5, -2.25), LAB(0.0, 0.0, 0.0, 1.0), LAB(100.0, -80.0, 90.0)};
+    for (Layout layout : {Layout::INTERLEAVED, Layout::PLANAR}) {
+        const auto decoded = serialization::view<LAB>(serialization::serialize(labs, layout)).to_vector();
+        REQUIRE(decoded.size() == labs.size());
+        for (size_t i = 0; i < labs.size(); ++i) {
+            CHECK(std::memcmp(&decoded[i], &labs[i], sizeof(LAB)) == 0);
+        }
+    }
+    CHECK_THROWS_AS(serialization::serialize(labs, Layout::DELTA), std::invalid_argument);
+}
+
+TEST_CASE("views reject a mismatched color type") {
+    const auto bytes = serialization::serialize(sample_colors(16));
+    CHECK_THROWS_AS(serialization::view<LAB>(bytes), std::runtime_error);
+    CHECK_THROWS_AS(serialization::view<MONO>(bytes), std::runtime_error);
+
+    auto bad_magic = bytes;
+    bad_magic[0] = 'X';
+    CHECK_THROWS_AS(serialization::view<RGB>(bad_magic), std::runtime_error);
+}
+
+TEST_CASE("views reject truncated payloads") {
+    for (Layout layout : ALL_LAYOUTS) {
+        const auto bytes = serialization::serialize(sample_colors(100), layout);
+        for (size_t keep : {size_t(0), sizeof(Header) - 1, sizeof(Header), bytes.size() - 1}) {
+            const std::vector<uint8_t> cut(bytes.begin(), bytes.begin() + static_cast<std::ptrdiff_t>(keep));
+            CHECK_THROWS_AS(serialization::view<RGB>(cut), std::runtime_error);
+        }
+    }
+
+    // A payload_size that disagrees with count for the raw layouts
+    auto bytes = serialization::serialize(sample_colors(100), Layout::PLANAR);
+    Header header = header_of(bytes);
+    header.count += 1;
+    set_header(bytes, header);
+    CHECK_THROWS_AS(serialization::view<RGB>(bytes), std::runtime_error);
+}
+
+TEST_CASE("delta decoding rejects a corrupt control stream") {
+    const auto colors = sample_colors(100);
+    const auto good = serialization::serialize(colors, Layout::DELTA);
+    std::vector<RGB> out(colors.size());
+
+    // First control byte claims a literal packet longer than the channel
+    auto too_long = good;
+    too_long[sizeof(Header)] = 127;
+    CHECK_THROWS_AS(serialization::view<RGB>(too_long).copy_to(out), std::runtime_error);
+
+    // Fewer colors in the header than the stream encodes leaves bytes over
+    auto leftover = good;
+    Header header = header_of(leftover);
+    header.count -= 1;
+    set_header(leftover, header);
+    CHECK_THROWS_AS(serialization::view<RGB>(leftover).copy_to(out), std::runtime_error);
+
+    // More colors than the stream encodes runs off the end
+    auto short_stream = good;
+    header = header_of(short_stream);
+    header.count += 1;
+    set_header(short_stream, header);
+    CHECK_THROWS_AS(serialization::view<RGB>(short_stream).to_vector(), std::runtime_error);
+
+    // Channel 0 is a complete run of two; channel 1's run packet has its value byte cut off
+    std::vector<uint8_t> dangling(sizeof(Header) + 3);
+    header = header_of(good);
+    header.count = 2;
+    header.payload_size = 3;
+    set_header(dangling, header);
+    dangling[sizeof(Header)] = 255;
+    dangling[sizeof(Header) + 1] = 7;
+    dangling[sizeof(Header) + 2] = 255;
+    CHECK_THROWS_AS(serialization::view<RGB>(dangling).to_vector(), std::runtime_error);
+}
+
+TEST_CASE("delta header count is bounded by what the payload can decode to") {
+    // 32 payload bytes of maximal runs decode to at most 16 * 128 values, or 512 RGB colors
+    std::vector<uint8_t> bytes(sizeof(Header) + 32);
+    for (size_t i = sizeof(Header); i < bytes.size(); i += 2) {
+        bytes[i] = 129;
+        bytes[i + 1] = 0;
+    }
+    const auto template_bytes = serialization::serialize(sample_colors(1), Layout::DELTA);
+    Header header = header_of(template_bytes);
+    header.payload_size = 32;
+
+    header.count = 512;
+    set_header(bytes, header);
+    const auto view = serialization::view<RGB>(bytes);
+    CHECK(view.size() == 512);
+    CHECK(view.to_vector().size() == 512);
+
+    for (uint64_t count : {uint64_t(513), uint64_t(1) << 40, ~uint64_t(0)}) {
+        header.count = count;
+        set_header(bytes, header);
+        CHECK_THROWS_AS(serialization::view<RGB>(bytes), std::runtime_error);
+    }
+}